@@ -0,0 +1,227 @@
+#include "alternative.h"
+#include <iterator>
+#include <algorithm>
+
+
+Restricted::Restricted(const Snapshot &snapshot)
+    : snapshot(snapshot)
+{
+    this->stamp = 1;
+    this->nodes.assign(snapshot.size(), 0);
+    this->arcs.assign(snapshot.countArcs(), 0);
+}
+
+void Restricted::clear()
+{
+    if (++this->stamp == 0)
+    {
+        this->nodes.assign(this->nodes.size(), 0);
+        this->arcs.assign(this->arcs.size(), 0);
+        this->stamp = 1;
+    }
+}
+
+void Restricted::banNode(std::size_t index)
+{
+    this->nodes[index] = this->stamp;
+}
+
+void Restricted::banArc(std::size_t arc)
+{
+    this->arcs[arc] = this->stamp;
+}
+
+std::size_t Restricted::size() const
+{
+    return this->snapshot.size();
+}
+
+double Restricted::getWeight() const
+{
+    return this->snapshot.getWeight();
+}
+
+const Point &Restricted::getPoint(std::size_t index) const
+{
+    return this->snapshot.getPoint(index);
+}
+
+std::size_t Restricted::getID(std::size_t index) const
+{
+    return this->snapshot.getID(index);
+}
+
+
+std::size_t Alternatives::findArc(std::size_t src, std::size_t dst) const
+{
+    for (std::size_t e = this->snapshot.begin(src);
+         e < this->snapshot.end(src); ++e)
+        if (this->snapshot.target(e) == dst)
+            return e;
+
+    return -1;
+}
+
+double Alternatives::measure(const std::vector<std::size_t> &arcs) const
+{
+    double costs = 0;
+
+    for (std::size_t i = 0; i < arcs.size(); ++i)
+        costs += this->snapshot.cost(arcs[i]);
+
+    return costs;
+}
+
+double Alternatives::share(const std::vector<std::size_t> &a,
+                           const std::vector<std::size_t> &b) const
+{
+    std::vector<std::size_t> sortedA(a), sortedB(b), shared;
+    std::sort(sortedA.begin(), sortedA.end());
+    std::sort(sortedB.begin(), sortedB.end());
+    std::set_intersection(sortedA.begin(), sortedA.end(),
+                          sortedB.begin(), sortedB.end(),
+                          std::back_inserter(shared));
+
+    return this->measure(shared);
+}
+
+bool Alternatives::spur(std::size_t src, std::size_t dst,
+                        std::vector<std::size_t> &arcs)
+{
+    Spherical<Restricted> heuristic;
+    solve<Restricted, Spherical<Restricted>, BinaryHeap<double>,
+          double, StopAtTarget>(this->restricted, heuristic,
+                                this->queue, this->space, src, dst);
+
+    if (!this->space.seen(dst) ||
+        this->space.costs[dst] == Traits<double>::infinity())
+        return false;
+
+    arcs.clear();
+
+    for (std::size_t v = dst; v != src; v = this->space.prevs[v])
+        arcs.push_back(this->findArc(this->space.prevs[v], v));
+
+    std::reverse(arcs.begin(), arcs.end());
+
+    return true;
+}
+
+Alternatives::Alternatives(const Snapshot &snapshot, std::size_t count,
+                           double overlap, double stretch)
+    : snapshot(snapshot), restricted(snapshot)
+{
+    this->count = count;
+    this->overlap = overlap;
+    this->stretch = stretch;
+    this->srcID = -1;
+}
+
+void Alternatives::findPaths(std::size_t srcID, std::size_t dstID)
+{
+    std::size_t src = this->snapshot.find(srcID),
+                dst = this->snapshot.find(dstID);
+    this->srcID = srcID;
+    this->paths.clear();
+    this->costs.clear();
+
+    if (src >= this->snapshot.size() || dst >= this->snapshot.size() ||
+        !this->count)
+        return;
+
+    std::vector<std::vector<std::size_t> > found;
+    std::set<std::pair<double, std::vector<std::size_t> > > candidates;
+    std::set<std::vector<std::size_t> > seen;
+    std::vector<std::size_t> arcs;
+    this->restricted.clear();
+
+    if (!this->spur(src, dst, arcs))
+        return;
+
+    candidates.insert(std::make_pair(this->measure(arcs), arcs));
+    seen.insert(arcs);
+    double best = candidates.begin()->first;
+
+    for (std::size_t round = 0;
+         round < this->count * 20 && !candidates.empty() &&
+         this->paths.size() < this->count;
+         ++round)
+    {
+        double costs = candidates.begin()->first;
+        std::vector<std::size_t> path = candidates.begin()->second;
+        candidates.erase(candidates.begin());
+
+        if (costs > best * this->stretch)
+            break;
+
+        found.push_back(path);
+        bool distinct = true;
+
+        for (std::size_t i = 0; i < this->paths.size() && distinct; ++i)
+            if (this->share(path, this->paths[i]) >
+                this->overlap * costs)
+                distinct = false;
+
+        if (distinct)
+        {
+            this->paths.push_back(path);
+            this->costs.push_back(costs);
+        }
+
+        std::size_t node = src;
+
+        for (std::size_t i = 0; i < path.size(); ++i)
+        {
+            this->restricted.clear();
+
+            for (std::size_t j = 0; j < found.size(); ++j)
+                if (found[j].size() > i &&
+                    std::equal(path.begin(), path.begin() + i,
+                               found[j].begin()))
+                    this->restricted.banArc(found[j][i]);
+
+            for (std::size_t j = 0; j < i; ++j)
+                this->restricted.banNode(
+                    j ? this->snapshot.target(path[j - 1]) : src);
+
+            if (this->spur(node, dst, arcs))
+            {
+                std::vector<std::size_t> total(path.begin(),
+                                               path.begin() + i);
+                total.insert(total.end(), arcs.begin(), arcs.end());
+
+                if (seen.insert(total).second)
+                    candidates.insert(std::make_pair(
+                        this->measure(total), total));
+            }
+
+            node = this->snapshot.target(path[i]);
+        }
+    }
+}
+
+std::size_t Alternatives::size() const
+{
+    return this->paths.size();
+}
+
+std::vector<std::size_t> Alternatives::getPath(std::size_t i) const
+{
+    std::vector<std::size_t> path;
+
+    if (i >= this->paths.size())
+        return path;
+
+    path.push_back(this->srcID);
+
+    for (std::size_t j = 0; j < this->paths[i].size(); ++j)
+        path.push_back(this->snapshot.getID(
+            this->snapshot.target(this->paths[i][j])));
+
+    return path;
+}
+
+double Alternatives::getCosts(std::size_t i) const
+{
+    return i < this->paths.size() ? this->costs[i] : -1;
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef ALTERNATIVE_H
+#define ALTERNATIVE_H
+
+#include "snapshot.h"
+#include "kernel.h"
+#include <set>
+
+
+class Restricted
+{
+    const Snapshot &snapshot;
+    unsigned stamp;
+    std::vector<unsigned> nodes;
+    std::vector<unsigned> arcs;
+
+public:
+    class Arcs
+    {
+        const Restricted &graph;
+        std::size_t arc;
+        std::size_t last;
+
+        void skip()
+        {
+            while (this->arc < this->last &&
+                   (this->graph.arcs[this->arc] == this->graph.stamp ||
+                    this->graph.nodes[this->target()] == this->graph.stamp))
+                ++this->arc;
+        }
+
+    public:
+        Arcs(const Restricted &graph, std::size_t index)
+            : graph(graph)
+        {
+            this->arc = graph.snapshot.begin(index);
+            this->last = graph.snapshot.end(index);
+            this->skip();
+        }
+
+        bool valid() const { return this->arc < this->last; }
+        void next() { ++this->arc, this->skip(); }
+        std::size_t target() const { return this->graph.snapshot.target(this->arc); }
+        double cost() const { return this->graph.snapshot.cost(this->arc); }
+    };
+
+    Restricted(const Snapshot &);
+
+    void clear();
+    void banNode(std::size_t);
+    void banArc(std::size_t);
+    std::size_t size() const;
+    double getWeight() const;
+    const Point &getPoint(std::size_t) const;
+    std::size_t getID(std::size_t) const;
+};
+
+
+class Alternatives
+{
+    const Snapshot &snapshot;
+    std::size_t count;
+    double overlap;
+    double stretch;
+    std::size_t srcID;
+    Restricted restricted;
+    Workspace<double> space;
+    BinaryHeap<double> queue;
+    std::vector<std::vector<std::size_t> > paths;
+    std::vector<double> costs;
+
+    std::size_t findArc(std::size_t, std::size_t) const;
+    double measure(const std::vector<std::size_t> &) const;
+    double share(const std::vector<std::size_t> &,
+                 const std::vector<std::size_t> &) const;
+    bool spur(std::size_t, std::size_t,
+              std::vector<std::size_t> &);
+
+public:
+    Alternatives(const Snapshot &, std::size_t = 3,
+                 double = 0.8, double = 1.5);
+
+    void findPaths(std::size_t, std::size_t);
+    std::size_t size() const;
+    std::vector<std::size_t> getPath(std::size_t) const;
+    double getCosts(std::size_t) const;
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "graph.h"
+#include "snapshot.h"
+#include "search.h"
+#include "distributed.h"
+#include "parallel.h"
+#include "metrics.h"
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+#if __cplusplus >= 201103L
+#include <chrono>
+#endif
+
+
+static double now()
+{
+#if __cplusplus >= 201103L
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#elif defined(__unix__) || defined(__APPLE__)
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+#else
+    return (double)std::clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static void build(Graph &graph, std::size_t side)
+{
+    std::srand(1);
+
+    for (std::size_t i = 0; i < side; ++i)
+        for (std::size_t j = 0; j < side; ++j)
+            graph.insertPoint(i * side + j,
+                              1.0 + 0.3 * i / side,
+                              0.3 * j / side);
+
+    for (std::size_t i = 0; i < side; ++i)
+        for (std::size_t j = 0; j < side; ++j)
+            for (std::size_t k = 0; k < 2; ++k)
+            {
+                std::size_t srcID = i * side + j,
+                            dstID = k ? srcID + 1 : srcID + side;
+
+                if ((k ? j + 1 : i + 1) >= side || std::rand() % 10 == 0)
+                    continue;
+
+                double cost = graph.getWeight() *
+                              (Point(1.0 + 0.3 * i / side, 0.3 * j / side) ^
+                               Point(1.0 + 0.3 * (i + !k) / side,
+                                     0.3 * (j + k) / side)) *
+                              (1 + 0.5 * std::rand() / RAND_MAX);
+                graph.insertRoute(srcID, dstID, cost);
+
+                if (std::rand() % 8)
+                    graph.insertRoute(dstID, srcID, cost);
+            }
+}
+
+
+int main(int argc, char **argv)
+{
+    std::size_t side = argc > 1 ? std::atoi(argv[1]) : 300,
+                queries = argc > 2 ? std::atoi(argv[2]) : 50;
+    Graph graph(6371);
+    build(graph, side);
+    Snapshot snapshot(graph);
+    Search search(snapshot);
+    std::vector<std::size_t> srcIDs, dstIDs;
+    std::vector<double> costs(queries);
+
+    std::srand(2);
+
+    for (std::size_t q = 0; q < queries; ++q)
+    {
+        srcIDs.push_back(std::rand() % (side * side));
+        dstIDs.push_back(std::rand() % (side * side));
+    }
+
+    double start, timings[2] = {1e300, 1e300};
+    std::size_t expanded = 0;
+
+    for (std::size_t round = 0; round < 6; ++round)
+    {
+        Metrics::enable(round % 2);
+        expanded = 0;
+        start = now();
+
+        for (std::size_t q = 0; q < queries; ++q)
+        {
+            graph.initialize(srcIDs[q], dstIDs[q]);
+            graph.findPath();
+            costs[q] = graph.getCosts();
+            expanded += graph.countExpanded();
+        }
+
+        timings[round % 2] = std::min(timings[round % 2], now() - start);
+    }
+
+    double base = timings[0];
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Vertices: " << snapshot.size()
+              << ", Arcs: " << snapshot.countArcs()
+              << ", Queries: " << queries
+              << ", Hardware threads: " << countThreads(0) << std::endl;
+    std::cout << "  Graph: " << base << "s, "
+              << expanded << " expanded, metrics overhead "
+              << 100 * (timings[1] / timings[0] - 1) << "%, findPath p50 "
+              << Metrics::getQuantile(TIMER_FIND_PATH, 0.5) * 1e3
+              << "ms, p99 "
+              << Metrics::getQuantile(TIMER_FIND_PATH, 0.99) * 1e3
+              << "ms" << std::endl;
+
+    Metrics::enable(false);
+    expanded = 0;
+    start = now();
+
+    for (std::size_t q = 0; q < queries; ++q)
+    {
+        search.findPath(srcIDs[q], dstIDs[q]);
+        expanded += search.countExpanded();
+    }
+
+    double elapsed = now() - start;
+    std::cout << "  Search: " << elapsed << "s, speedup "
+              << base / elapsed << ", " << expanded << " expanded"
+              << std::endl;
+
+    for (std::size_t threads = 1; threads <= 16; threads *= 2)
+    {
+        Distributed distributed(snapshot, threads);
+        std::size_t mismatches = 0;
+        expanded = 0;
+        start = now();
+
+        for (std::size_t q = 0; q < queries; ++q)
+        {
+            distributed.findPath(srcIDs[q], dstIDs[q]);
+            expanded += distributed.countExpanded();
+
+            if (std::fabs(distributed.getCosts() - costs[q]) >
+                1e-9 * costs[q])
+                ++mismatches;
+        }
+
+        elapsed = now() - start;
+        std::cout << "  Threads " << std::setw(2)
+                  << distributed.countThreads() << ": " << elapsed
+                  << "s, speedup " << base / elapsed << ", "
+                  << expanded << " expanded, "
+                  << mismatches << " mismatches"
+                  << (distributed.countThreads() > countThreads(0)
+                          ? ", oversubscribed"
+                          : "")
+                  << std::endl;
+    }
+
+    if (countThreads(0) < 16)
+        std::cout << "  Scaling incomplete: needs 16 hardware threads, "
+                  << "found " << countThreads(0) << std::endl;
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,402 @@
+#include "component.h"
+#include "graph.h"
+#include <algorithm>
+#include <utility>
+
+
+static const std::size_t BITS = sizeof(std::size_t) * 8;
+static const std::size_t CLOSURE_BYTES = 1 << 26;
+
+
+void Components::rebuild(const Points &points,
+                         const Routes &routes)
+{
+    std::vector<std::size_t> IDs;
+    std::vector<Point> coords;
+    std::vector<Route> edges;
+    std::vector<double> costs;
+    points.copy(IDs, coords);
+    routes.copy(edges, costs);
+
+    std::size_t size = IDs.size(), none = -1;
+    std::vector<std::size_t> offsets(size + 1, 0),
+        targets(edges.size());
+
+    for (std::size_t i = 0; i < edges.size(); ++i)
+        ++offsets[std::lower_bound(IDs.begin(), IDs.end(),
+                                   edges[i].srcID) -
+                  IDs.begin() + 1];
+
+    for (std::size_t i = 0; i < size; ++i)
+        offsets[i + 1] += offsets[i];
+
+    for (std::size_t i = 0; i < edges.size(); ++i)
+        targets[i] = std::lower_bound(IDs.begin(), IDs.end(),
+                                      edges[i].dstID) -
+                     IDs.begin();
+
+    std::vector<std::size_t> indices(size, none), lows(size),
+        comps(size, none), stack, frames, cursors;
+    std::size_t counter = 0, count = 0;
+
+    for (std::size_t root = 0; root < size; ++root)
+    {
+        if (indices[root] != none)
+            continue;
+
+        indices[root] = lows[root] = counter++;
+        stack.push_back(root);
+        frames.push_back(root);
+        cursors.push_back(offsets[root]);
+
+        while (!frames.empty())
+        {
+            std::size_t v = frames.back(),
+                        &cursor = cursors.back();
+
+            if (cursor < offsets[v + 1])
+            {
+                std::size_t w = targets[cursor++];
+
+                if (indices[w] == none)
+                {
+                    indices[w] = lows[w] = counter++;
+                    stack.push_back(w);
+                    frames.push_back(w);
+                    cursors.push_back(offsets[w]);
+                }
+                else if (comps[w] == none)
+                    lows[v] = std::min(lows[v], indices[w]);
+
+                continue;
+            }
+
+            frames.pop_back();
+            cursors.pop_back();
+
+            if (lows[v] == indices[v])
+            {
+                std::size_t w;
+
+                do
+                {
+                    w = stack.back();
+                    stack.pop_back();
+                    comps[w] = count;
+                } while (w != v);
+
+                ++count;
+            }
+
+            if (!frames.empty())
+                lows[frames.back()] = std::min(lows[frames.back()],
+                                               lows[v]);
+        }
+    }
+
+    this->labels.clear();
+
+    for (std::size_t i = 0; i < size; ++i)
+        this->labels.insert(this->labels.end(),
+                            std::make_pair(IDs[i], comps[i]));
+
+    this->ranks.resize(count);
+    this->groups.resize(count);
+    this->stamps.assign(count, 0);
+    this->stamp = 0;
+    this->succs.assign(count, std::vector<std::size_t>());
+    this->preds.assign(count, std::vector<std::size_t>());
+    this->closed = false;
+    this->oversized = false;
+
+    for (std::size_t c = 0; c < count; ++c)
+        this->ranks[c] = this->groups[c] = c;
+
+    std::vector<std::pair<std::size_t, std::size_t> > arcs;
+
+    for (std::size_t v = 0; v < size; ++v)
+        for (std::size_t e = offsets[v]; e < offsets[v + 1]; ++e)
+            if (comps[v] != comps[targets[e]])
+                arcs.push_back(std::make_pair(comps[v],
+                                              comps[targets[e]]));
+
+    std::sort(arcs.begin(), arcs.end());
+    arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+
+    for (std::size_t i = 0; i < arcs.size(); ++i)
+        this->link(arcs[i].first, arcs[i].second);
+
+    this->dirty = false;
+}
+
+void Components::link(std::size_t a, std::size_t b)
+{
+    std::vector<std::size_t> &succs = this->succs[a],
+                             &preds = this->preds[b];
+    std::vector<std::size_t>::iterator iter =
+        std::lower_bound(succs.begin(), succs.end(), b);
+
+    if (iter != succs.end() && *iter == b)
+        return;
+
+    succs.insert(iter, b);
+    preds.insert(std::lower_bound(preds.begin(), preds.end(), a), a);
+    this->groups[this->findGroup(a)] = this->findGroup(b);
+
+    if (this->closed)
+        this->merge(a, b);
+}
+
+void Components::reorder(std::size_t a, std::size_t b)
+{
+    std::vector<std::size_t> forward, backward;
+    this->collect(b, this->ranks[a], true, forward);
+
+    if (this->stamps[a] == this->stamp)
+    {
+        this->dirty = true;
+        return;
+    }
+
+    this->collect(a, this->ranks[b], false, backward);
+    std::vector<std::pair<std::size_t, std::size_t> >
+        lower, upper;
+    std::vector<std::size_t> pool;
+
+    for (std::size_t i = 0; i < forward.size(); ++i)
+    {
+        lower.push_back(std::make_pair(this->ranks[forward[i]],
+                                       forward[i]));
+        pool.push_back(this->ranks[forward[i]]);
+    }
+
+    for (std::size_t i = 0; i < backward.size(); ++i)
+    {
+        upper.push_back(std::make_pair(this->ranks[backward[i]],
+                                       backward[i]));
+        pool.push_back(this->ranks[backward[i]]);
+    }
+
+    std::sort(lower.begin(), lower.end());
+    std::sort(upper.begin(), upper.end());
+    std::sort(pool.begin(), pool.end());
+
+    for (std::size_t i = 0; i < lower.size(); ++i)
+        this->ranks[lower[i].second] = pool[i];
+
+    for (std::size_t i = 0; i < upper.size(); ++i)
+        this->ranks[upper[i].second] = pool[lower.size() + i];
+}
+
+void Components::collect(std::size_t from, std::size_t bound,
+                         bool forward,
+                         std::vector<std::size_t> &found)
+{
+    ++this->stamp;
+    std::vector<std::size_t> stack(1, from);
+    this->stamps[from] = this->stamp;
+
+    while (!stack.empty())
+    {
+        std::size_t c = stack.back();
+        stack.pop_back();
+        found.push_back(c);
+        const std::vector<std::size_t> &nexts =
+            forward ? this->succs[c] : this->preds[c];
+
+        for (std::size_t i = 0; i < nexts.size(); ++i)
+        {
+            std::size_t n = nexts[i];
+
+            if (this->stamps[n] == this->stamp ||
+                (forward ? this->ranks[n] < bound
+                         : this->ranks[n] > bound))
+                continue;
+
+            this->stamps[n] = this->stamp;
+            stack.push_back(n);
+        }
+    }
+}
+
+void Components::close()
+{
+    std::size_t count = this->ranks.size();
+    this->stride = (count + count / 4) / BITS + 1;
+    this->closed = count * this->stride * sizeof(std::size_t) <=
+                   CLOSURE_BYTES;
+    this->oversized = !this->closed;
+    this->closure.clear();
+
+    if (!this->closed)
+        return;
+
+    std::vector<std::size_t> order(count);
+    this->closure.assign(count * this->stride, 0);
+
+    for (std::size_t c = 0; c < count; ++c)
+        order[this->ranks[c]] = c;
+
+    for (std::size_t r = 0; r < count; ++r)
+    {
+        std::size_t c = order[r], *row = &this->closure[c * this->stride];
+        row[c / BITS] |= (std::size_t)1 << c % BITS;
+
+        for (std::size_t i = 0; i < this->succs[c].size(); ++i)
+        {
+            const std::size_t *next =
+                &this->closure[this->succs[c][i] * this->stride];
+
+            for (std::size_t w = 0; w < this->stride; ++w)
+                row[w] |= next[w];
+        }
+    }
+}
+
+void Components::merge(std::size_t a, std::size_t b)
+{
+    if (this->find(a, b))
+        return;
+
+    const std::size_t *next = &this->closure[b * this->stride];
+    std::vector<std::size_t> stack(1, a);
+    this->stamps[a] = ++this->stamp;
+
+    while (!stack.empty())
+    {
+        std::size_t c = stack.back(), *row = &this->closure[c * this->stride];
+        stack.pop_back();
+
+        for (std::size_t w = 0; w < this->stride; ++w)
+            row[w] |= next[w];
+
+        for (std::size_t i = 0; i < this->preds[c].size(); ++i)
+        {
+            std::size_t p = this->preds[c][i];
+
+            if (this->stamps[p] == this->stamp || this->find(p, b))
+                continue;
+
+            this->stamps[p] = this->stamp;
+            stack.push_back(p);
+        }
+    }
+}
+
+bool Components::find(std::size_t a, std::size_t b) const
+{
+    return this->closure[a * this->stride + b / BITS] >> b % BITS & 1;
+}
+
+std::size_t Components::findGroup(std::size_t c)
+{
+    while (this->groups[c] != c)
+        c = this->groups[c] = this->groups[this->groups[c]];
+
+    return c;
+}
+
+Components::Components()
+{
+    this->dirty = true;
+    this->closed = false;
+    this->oversized = false;
+    this->stamp = 0;
+    this->stride = 0;
+}
+
+void Components::insertPoint(std::size_t ID)
+{
+    if (this->dirty || this->labels.count(ID))
+        return;
+
+    std::size_t c = this->ranks.size();
+    this->labels[ID] = c;
+    this->ranks.push_back(c);
+    this->groups.push_back(c);
+    this->stamps.push_back(0);
+    this->succs.push_back(std::vector<std::size_t>());
+    this->preds.push_back(std::vector<std::size_t>());
+
+    if (!this->closed)
+        return;
+
+    if (c < this->stride * BITS)
+    {
+        this->closure.resize((c + 1) * this->stride, 0);
+        this->closure[c * this->stride + c / BITS] |=
+            (std::size_t)1 << c % BITS;
+    }
+    else
+        this->closed = false;
+}
+
+void Components::insertRoute(std::size_t srcID, std::size_t dstID)
+{
+    if (this->dirty)
+        return;
+
+    std::map<std::size_t, std::size_t>::const_iterator
+        srcIter = this->labels.find(srcID),
+        dstIter = this->labels.find(dstID);
+
+    if (srcIter == this->labels.end() ||
+        dstIter == this->labels.end())
+    {
+        this->dirty = true;
+        return;
+    }
+
+    std::size_t a = srcIter->second, b = dstIter->second;
+
+    if (a == b)
+        return;
+
+    if (this->ranks[a] < this->ranks[b])
+        this->reorder(a, b);
+
+    if (!this->dirty)
+        this->link(a, b);
+}
+
+void Components::invalidate()
+{
+    this->dirty = true;
+}
+
+bool Components::reaches(const Points &points, const Routes &routes,
+                         std::size_t srcID, std::size_t dstID)
+{
+    if (this->dirty)
+        this->rebuild(points, routes);
+
+    std::size_t a = this->labels.find(srcID)->second,
+                b = this->labels.find(dstID)->second;
+
+    if (a == b)
+        return true;
+
+    if (this->findGroup(a) != this->findGroup(b) ||
+        this->ranks[a] < this->ranks[b])
+        return false;
+
+    if (!this->closed && !this->oversized)
+        this->close();
+
+    if (this->closed)
+        return this->find(a, b);
+
+    std::vector<std::size_t> found;
+    this->collect(a, this->ranks[b], true, found);
+
+    return this->stamps[b] == this->stamp;
+}
+
+std::size_t Components::size(const Points &points,
+                             const Routes &routes)
+{
+    if (this->dirty)
+        this->rebuild(points, routes);
+
+    return this->ranks.size();
+}
\ No newline at end of file
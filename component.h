@@ -0,0 +1,49 @@
+#ifndef COMPONENT_H
+#define COMPONENT_H
+
+#include <map>
+#include <vector>
+
+
+class Points;
+class Routes;
+
+
+class Components
+{
+    bool dirty;
+    bool closed;
+    bool oversized;
+    std::size_t stamp;
+    std::size_t stride;
+    std::map<std::size_t, std::size_t> labels;
+    std::vector<std::size_t> ranks;
+    std::vector<std::size_t> groups;
+    std::vector<std::size_t> stamps;
+    std::vector<std::vector<std::size_t> > succs;
+    std::vector<std::vector<std::size_t> > preds;
+    std::vector<std::size_t> closure;
+
+    void rebuild(const Points &, const Routes &);
+    void link(std::size_t, std::size_t);
+    void reorder(std::size_t, std::size_t);
+    void collect(std::size_t, std::size_t, bool,
+                 std::vector<std::size_t> &);
+    void close();
+    void merge(std::size_t, std::size_t);
+    bool find(std::size_t, std::size_t) const;
+    std::size_t findGroup(std::size_t);
+
+public:
+    Components();
+
+    void insertPoint(std::size_t);
+    void insertRoute(std::size_t, std::size_t);
+    void invalidate();
+    bool reaches(const Points &, const Routes &,
+                 std::size_t, std::size_t);
+    std::size_t size(const Points &, const Routes &);
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,326 @@
+#include "compressed.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+static std::size_t interleave(std::size_t bits)
+{
+    std::size_t code = 0;
+
+    for (std::size_t i = 0; i < 10; ++i)
+        code |= (bits >> i & 1) << 3 * i;
+
+    return code;
+}
+
+static void encodeUnit(double unitX, double unitY, double unitZ,
+                       double &octX, double &octY)
+{
+    double norm = std::fabs(unitX) + std::fabs(unitY) + std::fabs(unitZ);
+    octX = unitX / norm, octY = unitY / norm;
+
+    if (unitZ < 0)
+    {
+        double x = octX, y = octY;
+        octX = (1 - std::fabs(y)) * (x < 0 ? -1 : 1);
+        octY = (1 - std::fabs(x)) * (y < 0 ? -1 : 1);
+    }
+}
+
+void decodeUnit(short octX, short octY,
+                double &unitX, double &unitY, double &unitZ)
+{
+    double x = octX / 32767.0, y = octY / 32767.0;
+    unitZ = 1 - std::fabs(x) - std::fabs(y);
+
+    if (unitZ < 0)
+        unitX = (1 - std::fabs(y)) * (x < 0 ? -1 : 1),
+        unitY = (1 - std::fabs(x)) * (y < 0 ? -1 : 1);
+    else
+        unitX = x, unitY = y;
+
+    double norm = std::sqrt(unitX * unitX + unitY * unitY + unitZ * unitZ);
+    unitX /= norm, unitY /= norm, unitZ /= norm;
+}
+
+static double measureError(const Point &point,
+                           double unitX, double unitY, double unitZ)
+{
+    double x = point.unitX - unitX,
+           y = point.unitY - unitY,
+           z = point.unitZ - unitZ;
+
+    return 2 * std::asin(std::min(1.0, std::sqrt(x * x + y * y + z * z) / 2));
+}
+
+static void writeVarint(std::vector<unsigned char> &bytes, std::size_t value)
+{
+    while (value >= 0x80)
+        bytes.push_back((unsigned char)(value | 0x80)), value >>= 7;
+
+    bytes.push_back((unsigned char)value);
+}
+
+
+Compressed::Compressed(const Snapshot &snapshot, int costs, int vectors)
+{
+    std::size_t size = snapshot.size();
+    std::vector<std::pair<std::pair<std::size_t, std::size_t>,
+                          std::size_t> >
+        keys(size);
+    std::vector<std::size_t> ranks(size);
+    this->weight = snapshot.getWeight();
+    this->narrow = costs == COSTS_16BIT;
+    this->octahedral = vectors == VECTORS_OCTAHEDRAL;
+
+    for (std::size_t v = 0; v < size; ++v)
+    {
+        const Point &point = snapshot.getPoint(v);
+        double units[3] = {point.unitX, point.unitY, point.unitZ};
+        std::size_t coarse = 0, fine = 0;
+
+        for (std::size_t a = 0; a < 3; ++a)
+        {
+            std::size_t bits = (std::size_t)std::min(
+                1048575.0, std::max(0.0, (units[a] + 1) * 524288));
+            coarse |= interleave(bits >> 10) << a;
+            fine |= interleave(bits & 1023) << a;
+        }
+
+        keys[v] = std::make_pair(std::make_pair(coarse, fine), v);
+    }
+
+    std::sort(keys.begin(), keys.end());
+    this->IDs.resize(size);
+    this->order.resize(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        ranks[keys[i].second] = i;
+        this->IDs[i] = snapshot.getID(keys[i].second);
+    }
+
+    for (std::size_t v = 0; v < size; ++v)
+        this->order[v] = ranks[v];
+
+    double maximum = 0;
+
+    for (std::size_t e = 0; e < snapshot.countArcs(); ++e)
+        maximum = std::max(maximum, snapshot.cost(e));
+
+    double levels = this->narrow ? 65535.0 : 4294967295.0;
+    this->scale = maximum > 0 ? maximum / (levels - 1) : 1;
+    this->offsets.assign(1, 0);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        std::size_t v = keys[i].second;
+        std::vector<std::pair<std::size_t, unsigned> > arcs;
+
+        for (std::size_t e = snapshot.begin(v); e < snapshot.end(v); ++e)
+        {
+            double quantum = std::ceil(snapshot.cost(e) / this->scale);
+
+            if (quantum * this->scale < snapshot.cost(e))
+                ++quantum;
+
+            arcs.push_back(std::make_pair(ranks[snapshot.target(e)],
+                                          (unsigned)quantum));
+        }
+
+        std::sort(arcs.begin(), arcs.end());
+
+        for (std::size_t j = 0; j < arcs.size(); ++j)
+        {
+            if (j)
+                writeVarint(this->bytes, arcs[j].first - arcs[j - 1].first);
+            else if (arcs[j].first >= i)
+                writeVarint(this->bytes, (arcs[j].first - i) << 1);
+            else
+                writeVarint(this->bytes, (i - arcs[j].first - 1) << 1 | 1);
+
+            for (std::size_t b = 0; b < (this->narrow ? 2u : 4u); ++b)
+                this->bytes.push_back(
+                    (unsigned char)(arcs[j].second >> 8 * b));
+        }
+
+        this->offsets.push_back(this->bytes.size());
+    }
+
+    this->bytes.resize(this->bytes.size() + 4);
+    this->margin = 0;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const Point &point = snapshot.getPoint(keys[i].second);
+        double unitX, unitY, unitZ;
+
+        if (this->octahedral)
+        {
+            double octX, octY, best = std::numeric_limits<double>::infinity();
+            short codes[2] = {0, 0};
+            encodeUnit(point.unitX, point.unitY, point.unitZ, octX, octY);
+
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+                short x = (short)(c & 1 ? std::ceil(octX * 32767)
+                                        : std::floor(octX * 32767)),
+                      y = (short)(c & 2 ? std::ceil(octY * 32767)
+                                        : std::floor(octY * 32767));
+                decodeUnit(x, y, unitX, unitY, unitZ);
+                double error = measureError(point, unitX, unitY, unitZ);
+
+                if (error < best)
+                    best = error, codes[0] = x, codes[1] = y;
+            }
+
+            this->shorts.push_back(codes[0]);
+            this->shorts.push_back(codes[1]);
+        }
+        else
+        {
+            this->floats.push_back((float)point.unitX);
+            this->floats.push_back((float)point.unitY);
+            this->floats.push_back((float)point.unitZ);
+        }
+
+        this->getUnit(i, unitX, unitY, unitZ);
+        this->margin = std::max(this->margin,
+                                measureError(point, unitX, unitY, unitZ));
+    }
+
+    this->margin = 2 * this->margin + 1e-7;
+}
+
+std::size_t Compressed::size() const
+{
+    return this->IDs.size();
+}
+
+std::size_t Compressed::countArcs() const
+{
+    std::size_t arcs = 0;
+
+    for (std::size_t v = 0; v < this->size(); ++v)
+        for (Arcs iter(*this, v); iter.valid(); iter.next())
+            ++arcs;
+
+    return arcs;
+}
+
+std::size_t Compressed::countBytes() const
+{
+    return this->IDs.size() * sizeof(std::size_t) +
+           this->order.size() * sizeof(unsigned) +
+           this->offsets.size() * sizeof(std::size_t) +
+           this->bytes.size() +
+           this->floats.size() * sizeof(float) +
+           this->shorts.size() * sizeof(short);
+}
+
+std::size_t Compressed::find(std::size_t ID) const
+{
+    std::size_t lower = 0, upper = this->order.size();
+
+    while (lower < upper)
+    {
+        std::size_t middle = (lower + upper) / 2;
+
+        if (this->IDs[this->order[middle]] < ID)
+            lower = middle + 1;
+        else
+            upper = middle;
+    }
+
+    if (lower == this->order.size() || this->IDs[this->order[lower]] != ID)
+        return this->size();
+
+    return this->order[lower];
+}
+
+std::size_t Compressed::getID(std::size_t index) const
+{
+    return this->IDs[index];
+}
+
+double Compressed::getWeight() const
+{
+    return this->weight;
+}
+
+double Compressed::getMargin() const
+{
+    return this->margin;
+}
+
+void Compressed::getUnit(std::size_t index, double &unitX,
+                         double &unitY, double &unitZ) const
+{
+    if (this->octahedral)
+    {
+        decodeUnit(this->shorts[2 * index], this->shorts[2 * index + 1],
+                   unitX, unitY, unitZ);
+        return;
+    }
+
+    unitX = this->floats[3 * index];
+    unitY = this->floats[3 * index + 1];
+    unitZ = this->floats[3 * index + 2];
+}
+
+
+Compact::Compact(const Compressed &graph)
+    : graph(graph)
+{
+    this->src = this->dst = -1;
+    this->expanded = 0;
+}
+
+void Compact::findPath(std::size_t srcID, std::size_t dstID)
+{
+    this->src = this->graph.find(srcID);
+    this->dst = this->graph.find(dstID);
+    this->expanded = 0;
+
+    if (this->src >= this->graph.size() || this->dst >= this->graph.size())
+    {
+        this->src = this->dst = -1;
+        return;
+    }
+
+    Approximate<Compressed> heuristic;
+    this->expanded =
+        solve<Compressed, Approximate<Compressed>, BinaryHeap<double>,
+              double, StopAtTarget>(this->graph, heuristic, this->queue,
+                                    this->space, this->src, this->dst);
+}
+
+std::size_t Compact::countExpanded() const
+{
+    return this->expanded;
+}
+
+std::vector<std::size_t> Compact::getPath() const
+{
+    std::vector<std::size_t> path;
+
+    if (this->getCosts() == std::numeric_limits<double>::infinity())
+        return path;
+
+    for (std::size_t v = this->dst; v != (std::size_t)-1;
+         v = this->space.prevs[v])
+        path.push_back(this->graph.getID(v));
+
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
+
+double Compact::getCosts() const
+{
+    if (this->dst == (std::size_t)-1)
+        return std::numeric_limits<double>::infinity();
+
+    return this->space.getCosts(this->dst);
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+#ifndef COMPRESSED_H
+#define COMPRESSED_H
+
+#include "snapshot.h"
+#include "kernel.h"
+
+
+#ifndef COSTS_32BIT
+#define COSTS_32BIT 0
+#endif
+
+#ifndef COSTS_16BIT
+#define COSTS_16BIT 1
+#endif
+
+#ifndef VECTORS_FLOAT
+#define VECTORS_FLOAT 0
+#endif
+
+#ifndef VECTORS_OCTAHEDRAL
+#define VECTORS_OCTAHEDRAL 1
+#endif
+
+
+class Packed
+{
+    const unsigned char *pos;
+    const unsigned char *last;
+    double scale;
+    bool narrow;
+    bool more;
+    bool first;
+    std::size_t v;
+    double w;
+
+    void decode()
+    {
+        if (!(this->more = this->pos < this->last))
+            return;
+
+        std::size_t delta = 0;
+        unsigned shift = 0;
+
+        while (*this->pos & 0x80)
+            delta |= (std::size_t)(*this->pos++ & 0x7F) << shift,
+                shift += 7;
+
+        delta |= (std::size_t)*this->pos++ << shift;
+
+        if (this->first)
+            this->v += delta & 1 ? ~(delta >> 1) : delta >> 1,
+                this->first = false;
+        else
+            this->v += delta;
+
+        unsigned quantum = this->pos[0] | this->pos[1] << 8;
+
+        if (this->narrow)
+            this->pos += 2;
+        else
+            quantum |= (unsigned)this->pos[2] << 16 |
+                       (unsigned)this->pos[3] << 24,
+                this->pos += 4;
+
+        this->w = quantum * this->scale;
+    }
+
+public:
+    Packed(const unsigned char *pos, const unsigned char *last,
+           std::size_t index, double scale, bool narrow)
+    {
+        this->pos = pos;
+        this->last = last;
+        this->scale = scale;
+        this->narrow = narrow;
+        this->first = true;
+        this->v = index;
+        this->w = 0;
+        this->decode();
+    }
+
+    bool valid() const { return this->more; }
+    void next() { this->decode(); }
+    std::size_t target() const { return this->v; }
+    double cost() const { return this->w; }
+};
+
+
+void decodeUnit(short, short, double &, double &, double &);
+
+
+class Compressed
+{
+    double weight;
+    double scale;
+    double margin;
+    bool narrow;
+    bool octahedral;
+    std::vector<std::size_t> IDs;
+    std::vector<unsigned> order;
+    std::vector<std::size_t> offsets;
+    std::vector<unsigned char> bytes;
+    std::vector<float> floats;
+    std::vector<short> shorts;
+
+public:
+    class Arcs
+    {
+        Packed arcs;
+
+    public:
+        Arcs(const Compressed &graph, std::size_t index)
+            : arcs(&graph.bytes[0] + graph.offsets[index],
+                   &graph.bytes[0] + graph.offsets[index + 1],
+                   index, graph.scale, graph.narrow)
+        {
+        }
+
+        bool valid() const { return this->arcs.valid(); }
+        void next() { this->arcs.next(); }
+        std::size_t target() const { return this->arcs.target(); }
+        double cost() const { return this->arcs.cost(); }
+    };
+
+    Compressed(const Snapshot &, int = COSTS_32BIT, int = VECTORS_FLOAT);
+
+    std::size_t size() const;
+    std::size_t countArcs() const;
+    std::size_t countBytes() const;
+    std::size_t find(std::size_t) const;
+    std::size_t getID(std::size_t) const;
+    double getWeight() const;
+    double getMargin() const;
+    void getUnit(std::size_t, double &, double &, double &) const;
+
+    friend class Mapped;
+};
+
+
+template <class Graph_>
+struct Approximate
+{
+    static const bool blind = false;
+    double weight;
+    double margin;
+    double unitX, unitY, unitZ;
+
+    void reset(const Graph_ &graph, std::size_t dst)
+    {
+        this->weight = graph.getWeight();
+        this->margin = graph.getMargin();
+        graph.getUnit(dst, this->unitX, this->unitY, this->unitZ);
+    }
+
+    double operator()(const Graph_ &graph, std::size_t v) const
+    {
+        double unitX, unitY, unitZ;
+        graph.getUnit(v, unitX, unitY, unitZ);
+        double dot = unitX * this->unitX +
+                     unitY * this->unitY +
+                     unitZ * this->unitZ;
+
+        return this->weight *
+               std::max(0.0, std::acos(std::max(-1.0, std::min(1.0, dot))) -
+                                 this->margin);
+    }
+};
+
+
+class Compact
+{
+    const Compressed &graph;
+    std::size_t src;
+    std::size_t dst;
+    std::size_t expanded;
+    Workspace<double> space;
+    BinaryHeap<double> queue;
+
+public:
+    Compact(const Compressed &);
+
+    void findPath(std::size_t, std::size_t);
+    std::size_t countExpanded() const;
+    std::vector<std::size_t> getPath() const;
+    double getCosts() const;
+};
+
+
+#endif
\ No newline at end of file
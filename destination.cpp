@@ -0,0 +1,243 @@
+#include "destination.h"
+#include "graph.h"
+#include "metrics.h"
+#include <limits>
+#include <queue>
+#include <algorithm>
+#include <functional>
+
+
+Destinations::Table::Table()
+{
+    this->version = -1;
+    this->used = 0;
+}
+
+std::size_t Destinations::Table::countBytes() const
+{
+    return this->exact.size() * sizeof(double) +
+           this->packed.size() * sizeof(float);
+}
+
+void Destinations::Table::clear()
+{
+    std::vector<double>().swap(this->exact);
+    std::vector<float>().swap(this->packed);
+    this->version = -1;
+}
+
+
+void Destinations::build(const Points &points, const Routes &routes,
+                         std::size_t dstID, Table &table)
+{
+    typedef std::pair<double, std::size_t> Entry;
+    std::vector<std::size_t> IDs, srcIDs;
+    std::vector<Point> coords;
+    std::vector<double> costs, bounds;
+    std::priority_queue<Entry, std::vector<Entry>,
+                        std::greater<Entry> >
+        queue;
+    points.copy(IDs, coords);
+    bounds.assign(IDs.size(), std::numeric_limits<double>::infinity());
+
+    std::size_t dst = std::lower_bound(IDs.begin(), IDs.end(), dstID) -
+                      IDs.begin();
+    bounds[dst] = 0;
+    queue.push(Entry(0, dst));
+
+    while (!queue.empty())
+    {
+        Entry entry = queue.top();
+        queue.pop();
+
+        if (entry.first > bounds[entry.second])
+            continue;
+
+        routes.copy(srcIDs, costs, IDs[entry.second]);
+
+        for (std::size_t i = 0; i < srcIDs.size(); ++i)
+        {
+            std::size_t src = std::lower_bound(IDs.begin(), IDs.end(),
+                                               srcIDs[i]) -
+                              IDs.begin();
+            double bound = entry.first + costs[i];
+
+            if (bound < bounds[src])
+            {
+                bounds[src] = bound;
+                queue.push(Entry(bound, src));
+            }
+        }
+    }
+
+    table.clear();
+
+    if (this->compressed)
+    {
+        table.packed.resize(bounds.size());
+
+        for (std::size_t i = 0; i < bounds.size(); ++i)
+            table.packed[i] = (float)(bounds[i] * (1 - 1.2e-7));
+    }
+    else
+        table.exact.swap(bounds);
+}
+
+void Destinations::evict(std::size_t keepID, std::size_t extra)
+{
+    while (this->bytes + extra > this->budget)
+    {
+        std::map<std::size_t, Table>::iterator
+            lower = this->tables.begin(),
+            upper = this->tables.end(),
+            iter, oldest = upper;
+
+        for (iter = lower; iter != upper; ++iter)
+            if (iter->first != keepID && iter->second.countBytes() &&
+                (oldest == upper || iter->second.used < oldest->second.used))
+                oldest = iter;
+
+        if (oldest == upper)
+            return;
+
+        this->bytes -= oldest->second.countBytes();
+        oldest->second.clear();
+    }
+}
+
+
+Destinations::Destinations()
+{
+    this->budget = 1 << 26;
+    this->bytes = 0;
+    this->clock = 0;
+    this->hits = 0;
+    this->misses = 0;
+    this->compressed = false;
+}
+
+void Destinations::updateBudget(std::size_t budget, bool compressed)
+{
+    if (compressed != this->compressed)
+    {
+        std::map<std::size_t, Table>::iterator
+            lower = this->tables.begin(),
+            upper = this->tables.end(),
+            iter;
+
+        for (iter = lower; iter != upper; ++iter)
+            iter->second.clear();
+
+        this->bytes = 0;
+    }
+
+    this->budget = budget;
+    this->compressed = compressed;
+    this->evict(-1, 0);
+}
+
+void Destinations::insert(std::size_t ID)
+{
+    this->tables[ID];
+}
+
+void Destinations::erase(std::size_t ID)
+{
+    std::map<std::size_t, Table>::iterator iter = this->tables.find(ID);
+
+    if (iter != this->tables.end())
+    {
+        this->bytes -= iter->second.countBytes();
+        this->tables.erase(iter);
+    }
+}
+
+void Destinations::clear()
+{
+    this->tables.clear();
+    this->bytes = 0;
+}
+
+bool Destinations::copy(const Points &points, const Routes &routes,
+                        std::size_t version, std::size_t dstID,
+                        std::vector<double> &bounds)
+{
+    std::map<std::size_t, Table>::iterator iter = this->tables.find(dstID);
+
+    if (iter == this->tables.end())
+        return false;
+
+    Table &table = iter->second;
+    table.used = ++this->clock;
+
+    if (table.version == version && table.countBytes())
+    {
+        ++this->hits;
+        Metrics::count(COUNTER_HITS);
+    }
+    else
+    {
+        ++this->misses;
+        Metrics::count(COUNTER_MISSES);
+        std::size_t bytes = points.size() *
+                            (this->compressed ? sizeof(float)
+                                              : sizeof(double));
+        this->bytes -= table.countBytes();
+        table.clear();
+
+        if (bytes > this->budget)
+            return false;
+
+        this->evict(dstID, bytes);
+        this->build(points, routes, dstID, table);
+        table.version = version;
+        this->bytes += table.countBytes();
+    }
+
+    if (this->compressed)
+        bounds.assign(table.packed.begin(), table.packed.end());
+    else
+        bounds = table.exact;
+
+    return true;
+}
+
+bool Destinations::find(std::size_t ID) const
+{
+    return this->tables.find(ID) != this->tables.end();
+}
+
+std::size_t Destinations::size() const
+{
+    return this->tables.size();
+}
+
+std::size_t Destinations::countTables() const
+{
+    std::size_t count = 0;
+    std::map<std::size_t, Table>::const_iterator
+        const_lower = this->tables.begin(),
+        const_upper = this->tables.end(),
+        const_iter;
+
+    for (const_iter = const_lower;
+         const_iter != const_upper; ++const_iter)
+        count += const_iter->second.countBytes() != 0;
+
+    return count;
+}
+
+std::size_t Destinations::countBytes() const
+{
+    return this->bytes;
+}
+
+std::size_t Destinations::countHits() const
+{
+    return this->hits;
+}
+
+std::size_t Destinations::countMisses() const
+{
+    return this->misses;
+}
\ No newline at end of file
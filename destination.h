@@ -0,0 +1,58 @@
+#ifndef DESTINATION_H
+#define DESTINATION_H
+
+#include <map>
+#include <vector>
+
+
+class Points;
+class Routes;
+
+
+class Destinations
+{
+    struct Table
+    {
+        std::size_t version;
+        std::size_t used;
+        std::vector<double> exact;
+        std::vector<float> packed;
+
+        Table();
+
+        std::size_t countBytes() const;
+        void clear();
+    };
+
+    std::size_t budget;
+    std::size_t bytes;
+    std::size_t clock;
+    std::size_t hits;
+    std::size_t misses;
+    bool compressed;
+    std::map<std::size_t, Table> tables;
+
+    void build(const Points &, const Routes &,
+               std::size_t, Table &);
+    void evict(std::size_t, std::size_t);
+
+public:
+    Destinations();
+
+    void updateBudget(std::size_t, bool);
+    void insert(std::size_t);
+    void erase(std::size_t);
+    void clear();
+    bool copy(const Points &, const Routes &,
+              std::size_t, std::size_t,
+              std::vector<double> &);
+    bool find(std::size_t) const;
+    std::size_t size() const;
+    std::size_t countTables() const;
+    std::size_t countBytes() const;
+    std::size_t countHits() const;
+    std::size_t countMisses() const;
+};
+
+
+#endif
\ No newline at end of file
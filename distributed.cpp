@@ -0,0 +1,334 @@
+#include "distributed.h"
+#include "parallel.h"
+#include <limits>
+#include <algorithm>
+#if __cplusplus >= 201103L
+#include <atomic>
+#include <thread>
+#endif
+
+
+struct Message
+{
+    std::size_t v;
+    std::size_t prev;
+    double costs;
+};
+
+struct Batch
+{
+    std::vector<Message> messages;
+    Batch *next;
+};
+
+
+#if __cplusplus >= 201103L
+typedef std::atomic<Batch *> Inbox;
+typedef std::atomic<long> Counter;
+typedef std::atomic<double> Incumbent;
+
+static void give(Inbox &inbox, Batch *batch)
+{
+    batch->next = inbox.load(std::memory_order_relaxed);
+
+    while (!inbox.compare_exchange_weak(batch->next, batch,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed))
+        ;
+}
+
+static Batch *take(Inbox &inbox)
+{
+    if (!inbox.load(std::memory_order_relaxed))
+        return 0;
+
+    return inbox.exchange(0, std::memory_order_acquire);
+}
+
+static long add(Counter &counter, long value)
+{
+    return counter.fetch_add(value) + value;
+}
+
+static double load(const Incumbent &incumbent)
+{
+    return incumbent.load(std::memory_order_relaxed);
+}
+
+static void store(Incumbent &incumbent, double value)
+{
+    incumbent.store(value, std::memory_order_relaxed);
+}
+
+static void yield()
+{
+    std::this_thread::yield();
+}
+#else
+typedef Batch *Inbox;
+typedef long Counter;
+typedef double Incumbent;
+
+static void give(Inbox &inbox, Batch *batch)
+{
+    batch->next = inbox;
+    inbox = batch;
+}
+
+static Batch *take(Inbox &inbox)
+{
+    Batch *batch = inbox;
+    inbox = 0;
+
+    return batch;
+}
+
+static long add(Counter &counter, long value)
+{
+    return counter += value;
+}
+
+static double load(const Incumbent &incumbent)
+{
+    return incumbent;
+}
+
+static void store(Incumbent &incumbent, double value)
+{
+    incumbent = value;
+}
+
+static void yield()
+{
+}
+#endif
+
+
+struct Context
+{
+    Distributed *engine;
+    Spherical<Snapshot> heuristic;
+    std::vector<Inbox> inboxes;
+    std::vector<std::size_t> expanded;
+    Counter work;
+    Incumbent incumbent;
+
+    Context(std::size_t threads)
+        : inboxes(threads), expanded(threads, 0)
+    {
+        for (std::size_t t = 0; t < threads; ++t)
+            this->inboxes[t] = 0;
+    }
+};
+
+
+std::size_t Distributed::owner(std::size_t v) const
+{
+    return (std::size_t)((v * 2654435761u) >> 7 & 0xFFFFFF) % this->threads;
+}
+
+void Distributed::work(std::size_t thread, void *pointer)
+{
+    Context &context = *(Context *)pointer;
+    Distributed &engine = *context.engine;
+    const Snapshot &snapshot = engine.snapshot;
+    BinaryHeap<double> heap;
+    std::vector<std::vector<Message> > outboxes(engine.threads);
+    std::size_t expanded = 0, pending = 0, since = 0;
+    bool active = true;
+    Message seed = {engine.src, (std::size_t)-1, 0};
+    std::vector<Message> relaxed;
+
+    if (engine.owner(engine.src) == thread)
+        relaxed.push_back(seed);
+
+    while (true)
+    {
+        long received = 0;
+
+        for (Batch *batch = take(context.inboxes[thread]); batch;)
+        {
+            if (!active)
+            {
+                add(context.work, 1);
+                active = true;
+            }
+
+            relaxed.insert(relaxed.end(), batch->messages.begin(),
+                           batch->messages.end());
+            received += batch->messages.size();
+            Batch *next = batch->next;
+            delete batch;
+            batch = next;
+        }
+
+        for (std::size_t i = 0; i < relaxed.size(); ++i)
+        {
+            std::size_t v = relaxed[i].v;
+
+            if (engine.stamps[v] != engine.stamp)
+            {
+                engine.stamps[v] = engine.stamp;
+                engine.costs[v] = std::numeric_limits<double>::infinity();
+                engine.bounds[v] = context.heuristic(snapshot, v);
+            }
+
+            if (relaxed[i].costs < engine.costs[v])
+            {
+                engine.costs[v] = relaxed[i].costs;
+                engine.prevs[v] = relaxed[i].prev;
+                heap.push(relaxed[i].costs + engine.bounds[v], v);
+            }
+        }
+
+        relaxed.clear();
+
+        if (received)
+            add(context.work, -received);
+
+        double best = load(context.incumbent);
+
+        while (!heap.empty() &&
+               (heap.top().first >= best ||
+                heap.top().first > engine.costs[heap.top().second] +
+                                       engine.bounds[heap.top().second]))
+            heap.pop();
+
+        if (!heap.empty())
+        {
+            std::size_t v = heap.top().second;
+            double costs = engine.costs[v];
+            heap.pop();
+
+            if (v == engine.dst)
+            {
+                store(context.incumbent, costs);
+                continue;
+            }
+
+            ++expanded;
+
+            for (Snapshot::Arcs arcs(snapshot, v); arcs.valid(); arcs.next())
+            {
+                Message message = {arcs.target(), v, costs + arcs.cost()};
+                std::size_t owner = engine.owner(message.v);
+
+                if (owner == thread)
+                    relaxed.push_back(message);
+                else if (message.costs +
+                             context.heuristic(snapshot, message.v) <
+                         best)
+                    outboxes[owner].push_back(message), ++pending;
+            }
+
+            if (pending < 64 && ++since < 16)
+                continue;
+        }
+
+        since = 0;
+
+        for (std::size_t t = 0; t < outboxes.size(); ++t)
+            if (!outboxes[t].empty())
+            {
+                Batch *batch = new Batch;
+                batch->messages.swap(outboxes[t]);
+                add(context.work, batch->messages.size());
+                give(context.inboxes[t], batch);
+            }
+
+        if (pending || !relaxed.empty() || !heap.empty())
+        {
+            pending = 0;
+            continue;
+        }
+
+        if (active)
+        {
+            active = false;
+            add(context.work, -1);
+        }
+
+        if (!add(context.work, 0))
+            break;
+
+        yield();
+    }
+
+    context.expanded[thread] = expanded;
+}
+
+Distributed::Distributed(const Snapshot &snapshot, std::size_t threads)
+    : snapshot(snapshot)
+{
+    this->threads = ::countThreads(threads);
+    this->src = this->dst = -1;
+    this->expanded = 0;
+    this->stamp = 0;
+    this->stamps.assign(snapshot.size(), 0);
+    this->costs.resize(snapshot.size());
+    this->bounds.resize(snapshot.size());
+    this->prevs.resize(snapshot.size());
+}
+
+void Distributed::findPath(std::size_t srcID, std::size_t dstID)
+{
+    if (++this->stamp == 0)
+    {
+        this->stamps.assign(this->stamps.size(), 0);
+        this->stamp = 1;
+    }
+
+    this->src = this->snapshot.find(srcID);
+    this->dst = this->snapshot.find(dstID);
+    this->expanded = 0;
+
+    if (this->src >= this->snapshot.size() ||
+        this->dst >= this->snapshot.size())
+    {
+        this->src = this->dst = -1;
+        return;
+    }
+
+    Context context(this->threads);
+    context.engine = this;
+    context.heuristic.reset(this->snapshot, this->dst);
+    context.work = this->threads;
+    store(context.incumbent, std::numeric_limits<double>::infinity());
+    runThreads(this->threads, Distributed::work, &context);
+
+    for (std::size_t t = 0; t < this->threads; ++t)
+        this->expanded += context.expanded[t];
+}
+
+std::size_t Distributed::countExpanded() const
+{
+    return this->expanded;
+}
+
+std::size_t Distributed::countThreads() const
+{
+    return this->threads;
+}
+
+std::vector<std::size_t> Distributed::getPath() const
+{
+    std::vector<std::size_t> path;
+
+    if (this->getCosts() == std::numeric_limits<double>::infinity())
+        return path;
+
+    for (std::size_t v = this->dst; v != (std::size_t)-1; v = this->prevs[v])
+        path.push_back(this->snapshot.getID(v));
+
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
+
+double Distributed::getCosts() const
+{
+    if (this->dst == (std::size_t)-1 || this->stamps[this->dst] != this->stamp)
+        return std::numeric_limits<double>::infinity();
+
+    return this->costs[this->dst];
+}
\ No newline at end of file
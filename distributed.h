@@ -0,0 +1,35 @@
+#ifndef DISTRIBUTED_H
+#define DISTRIBUTED_H
+
+#include "snapshot.h"
+#include "kernel.h"
+
+
+class Distributed
+{
+    const Snapshot &snapshot;
+    std::size_t threads;
+    std::size_t src;
+    std::size_t dst;
+    std::size_t expanded;
+    unsigned stamp;
+    std::vector<unsigned> stamps;
+    std::vector<double> costs;
+    std::vector<double> bounds;
+    std::vector<std::size_t> prevs;
+
+    std::size_t owner(std::size_t) const;
+    static void work(std::size_t, void *);
+
+public:
+    Distributed(const Snapshot &, std::size_t = 0);
+
+    void findPath(std::size_t, std::size_t);
+    std::size_t countExpanded() const;
+    std::size_t countThreads() const;
+    std::vector<std::size_t> getPath() const;
+    double getCosts() const;
+};
+
+
+#endif
\ No newline at end of file
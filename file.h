@@ -1,26 +1,31 @@
-#ifndef FILE_H
-#define FILE_H
-
-#include "graph.h"
-#include <string>
-
-
-#ifndef FILE_NOT_FOUND
-#define FILE_NOT_FOUND 1
-#endif
-
-
-void insertPoints(const std::string &,
-                  Graph &);
-void erasePoints(const std::string &,
-                 Graph &);
-void insertRoutes(const std::string &,
-                  Graph &);
-void eraseRoutes(const std::string &,
-                 Graph &);
-void backup(const Graph &);
-void savePath(const Graph &,
-              const std::string &);
-
-
+#ifndef FILE_H
+#define FILE_H
+
+#include "graph.h"
+#include <string>
+
+
+#ifndef FILE_NOT_FOUND
+#define FILE_NOT_FOUND 1
+#endif
+
+
+void insertPoints(const std::string &,
+                  Graph &);
+void erasePoints(const std::string &,
+                 Graph &);
+void insertRoutes(const std::string &,
+                  Graph &);
+void eraseRoutes(const std::string &,
+                 Graph &);
+void backup(const Graph &);
+void savePath(const Graph &,
+              const std::string &);
+void savePaths(const std::string &,
+               const std::string &,
+               bool, Graph &);
+void saveCosts(const Graph &, std::size_t,
+               const std::string &);
+
+
 #endif
\ No newline at end of file
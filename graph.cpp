@@ -1,527 +1,943 @@
-#include "graph.h"
-#include <cmath>
-#include <limits>
-#include <algorithm>
-
-
-Point::Point()
-{
-}
-
-Point::Point(const Point &other)
-{
-    this->unitX = other.unitX;
-    this->unitY = other.unitY;
-    this->unitZ = other.unitZ;
-}
-
-Point::Point(double phi, double theta)
-{
-    this->unitX = std::sin(phi) * std::cos(theta);
-    this->unitY = std::sin(phi) * std::sin(theta);
-    this->unitZ = std::cos(phi);
-}
-
-double Point::operator*(const Point &other) const
-{
-    return this->unitX * other.unitX +
-           this->unitY * other.unitY +
-           this->unitZ * other.unitZ;
-}
-
-double Point::operator^(const Point &other) const
-{
-    return std::acos(*this * other);
-}
-
-
-Route::Route(std::size_t srcID, std::size_t dstID)
-{
-    this->srcID = srcID;
-    this->dstID = dstID;
-}
-
-bool Route::operator<(const Route &other) const
-{
-    if (this->srcID != other.srcID)
-        return this->srcID < other.srcID;
-
-    if (this->dstID != other.dstID)
-        return this->dstID < other.dstID;
-
-    return false;
-}
-
-bool Route::OrderByDstID::operator()(const Route &a,
-                                     const Route &b) const
-{
-    if (a.dstID != b.dstID)
-        return a.dstID < b.dstID;
-
-    if (a.srcID != b.srcID)
-        return a.srcID < b.srcID;
-
-    return false;
-}
-
-
-Node::Node(std::size_t currID)
-{
-    this->currID = currID;
-    this->prevID = -1;
-    this->found = false;
-    this->costs = std::numeric_limits<double>::infinity();
-}
-
-bool Node::operator<(const Node &other) const
-{
-    return this->currID < other.currID;
-}
-
-bool Node::MinHeap::operator()(const Node *a,
-                               const Node *b) const
-{
-    return a->score > b->score;
-}
-
-
-Points::Points()
-{
-}
-
-Point Points::operator[](std::size_t ID) const
-{
-    return this->points.find(ID)->second;
-}
-
-void Points::insert(std::size_t ID,
-                    double phi, double theta)
-{
-    this->points[ID] = Point(phi, theta);
-}
-
-void Points::erase(std::size_t ID)
-{
-    this->points.erase(ID);
-}
-
-void Points::clear()
-{
-    this->points.clear();
-}
-
-void Points::copy(std::vector<Node> &nodes) const
-{
-    nodes.reserve(this->points.size());
-    std::map<std::size_t, Point>::const_iterator
-        const_lower = this->points.begin(),
-        const_upper = this->points.end(),
-        const_iter;
-
-    for (const_iter = const_lower;
-         const_iter != const_upper; ++const_iter)
-        nodes.push_back(Node(const_iter->first));
-}
-
-void Points::copy(std::vector<std::size_t> &IDs,
-                  std::vector<Point> &points) const
-{
-    IDs.reserve(this->points.size());
-    points.reserve(this->points.size());
-    std::map<std::size_t, Point>::const_iterator
-        const_lower = this->points.begin(),
-        const_upper = this->points.end(),
-        const_iter;
-
-    for (const_iter = const_lower;
-         const_iter != const_upper; ++const_iter)
-    {
-        IDs.push_back(const_iter->first);
-        points.push_back(const_iter->second);
-    }
-}
-
-bool Points::find(std::size_t ID) const
-{
-    return this->points.find(ID) != this->points.end();
-}
-
-std::size_t Points::size() const
-{
-    return this->points.size();
-}
-
-
-Routes::Routes()
-{
-}
-
-double Routes::operator[](const Route &route) const
-{
-    return this->routesBySrcID.find(route)->second;
-}
-
-void Routes::insert(std::size_t srcID, std::size_t dstID,
-                    double cost)
-{
-    Route route(srcID, dstID);
-    this->routesBySrcID[route] = cost;
-    this->routesByDstID[route] = cost;
-}
-
-void Routes::erase(std::size_t srcID, std::size_t dstID)
-{
-    Route route(srcID, dstID);
-    this->routesBySrcID.erase(route);
-    this->routesByDstID.erase(route);
-}
-
-void Routes::erase(std::size_t ID)
-{
-    std::map<Route, double>::iterator
-        lowerSrc = this->routesBySrcID.lower_bound(Route(ID, 0)),
-        upperSrc = this->routesBySrcID.upper_bound(Route(ID, -1)),
-        iterSrc = lowerSrc;
-
-    while (iterSrc != upperSrc)
-    {
-        this->routesByDstID.erase(iterSrc->first);
-        this->routesBySrcID.erase(iterSrc++);
-    }
-
-    std::map<Route, double, Route::OrderByDstID>::iterator
-        lowerDst = this->routesByDstID.lower_bound(Route(0, ID)),
-        upperDst = this->routesByDstID.upper_bound(Route(-1, ID)),
-        iterDst = lowerDst;
-
-    while (iterDst != upperDst)
-    {
-        this->routesBySrcID.erase(iterDst->first);
-        this->routesByDstID.erase(iterDst++);
-    }
-}
-
-void Routes::clear()
-{
-    this->routesBySrcID.clear();
-    this->routesByDstID.clear();
-}
-
-void Routes::copy(std::vector<std::size_t> &dstIDs,
-                  std::size_t srcID) const
-{
-    dstIDs.clear();
-    std::map<Route, double>::const_iterator
-        const_lower = this->routesBySrcID.lower_bound(Route(srcID, 0)),
-        const_upper = this->routesBySrcID.upper_bound(Route(srcID, -1)),
-        const_iter;
-
-    for (const_iter = const_lower;
-         const_iter != const_upper; ++const_iter)
-        dstIDs.push_back(const_iter->first.dstID);
-}
-
-void Routes::copy(std::vector<Route> &routes,
-                  std::vector<double> &costs) const
-{
-    routes.reserve(this->routesBySrcID.size());
-    costs.reserve(this->routesBySrcID.size());
-    std::map<Route, double>::const_iterator
-        const_lower = this->routesBySrcID.begin(),
-        const_upper = this->routesBySrcID.end(),
-        const_iter;
-
-    for (const_iter = const_lower;
-         const_iter != const_upper; ++const_iter)
-    {
-        routes.push_back(const_iter->first);
-        costs.push_back(const_iter->second);
-    }
-}
-
-std::size_t Routes::size() const
-{
-    return this->routesBySrcID.size();
-}
-
-
-Nodes::Nodes()
-{
-}
-
-Nodes::Nodes(const Points &points,
-             std::size_t srcID, std::size_t dstID)
-{
-    points.copy(this->nodes);
-    this->nodes[this->find(srcID)].costs = 0;
-    Point dstPoint = points[dstID];
-
-    for (std::size_t i = 0; i < this->nodes.size(); ++i)
-        this->nodes[i].angle = points[this->nodes[i].currID] ^ dstPoint;
-}
-
-Node &Nodes::operator[](std::size_t index)
-{
-    return this->nodes[index];
-}
-
-Node Nodes::operator[](std::size_t index) const
-{
-    return this->nodes[index];
-}
-
-void Nodes::clear()
-{
-    this->nodes.clear();
-}
-
-std::size_t Nodes::size() const
-{
-    return this->nodes.size();
-}
-
-std::size_t Nodes::find(std::size_t ID) const
-{
-    return std::lower_bound(this->nodes.begin(),
-                            this->nodes.end(), Node(ID)) -
-           this->nodes.begin();
-}
-
-
-void Graph::markID(std::size_t ID)
-{
-    this->nodes[this->nodes.find(ID)].found = true;
-}
-
-void Graph::update(std::size_t currID, std::size_t nextID)
-{
-    double costs = this->getCosts(currID) +
-                   this->routes[Route(currID, nextID)];
-    Node &nextNode = this->nodes[this->nodes.find(nextID)];
-
-    if (costs < nextNode.costs)
-    {
-        nextNode.prevID = currID;
-        nextNode.costs = costs;
-        nextNode.score = costs + this->weight * nextNode.angle;
-    }
-}
-
-bool Graph::check(std::size_t srcID, std::size_t dstID) const
-{
-    if (srcID == dstID)
-        throw INVALID_ROUTE_1;
-
-    Point srcPoint = this->points[srcID],
-          dstPoint = this->points[dstID];
-
-    if (this->routes[Route(srcID, dstID)] <
-        this->weight * (srcPoint ^ dstPoint))
-        throw INVALID_ROUTE_2;
-
-    return true;
-}
-
-bool Graph::isNew(std::size_t ID) const
-{
-    if (ID == this->dstID)
-        return false;
-
-    if (this->nodes[this->nodes.find(ID)].found)
-        return false;
-
-    return true;
-}
-
-std::size_t Graph::getPrevID(std::size_t ID) const
-{
-    return this->nodes[this->nodes.find(ID)].prevID;
-}
-
-double Graph::getCosts(std::size_t ID) const
-{
-    return this->nodes[this->nodes.find(ID)].costs;
-}
-
-double Graph::getScore(std::size_t ID) const
-{
-    return this->nodes[this->nodes.find(ID)].score;
-}
-
-Graph::Graph(double weight)
-{
-    this->ready = false;
-    this->done = false;
-    this->weight = weight;
-}
-
-void Graph::updateWeight(double weight)
-{
-    if (weight < 0)
-        throw NEGATIVE_WEIGHT;
-
-    if (weight > this->weight)
-    {
-        this->weight = weight;
-        this->routes.clear();
-
-        throw INCREASED_WEIGHT;
-    }
-
-    this->weight = weight;
-}
-
-void Graph::insertPoint(std::size_t ID,
-                        double phi, double theta)
-{
-    this->points.insert(ID, phi, theta);
-}
-
-void Graph::erasePoint(std::size_t ID)
-{
-    this->points.erase(ID);
-    this->routes.erase(ID);
-    this->ready = false;
-    this->done = false;
-}
-
-void Graph::clearPoints()
-{
-    this->points.clear();
-    this->routes.clear();
-    this->ready = false;
-    this->done = false;
-}
-
-void Graph::insertRoute(std::size_t srcID, std::size_t dstID,
-                        double cost)
-{
-    if (this->points.find(srcID) && this->points.find(dstID) &&
-        this->check(srcID, dstID))
-    {
-        this->routes.insert(srcID, dstID, cost);
-        this->ready = false;
-        this->done = false;
-    }
-}
-
-void Graph::eraseRoute(std::size_t srcID, std::size_t dstID)
-{
-    this->routes.erase(srcID, dstID);
-    this->ready = false;
-    this->done = false;
-}
-
-void Graph::clearRoutes()
-{
-    this->routes.clear();
-    this->ready = false;
-    this->done = false;
-}
-
-void Graph::copy(std::vector<std::size_t> &IDs,
-                 std::vector<Point> &points,
-                 std::vector<Route> &routes,
-                 std::vector<double> &costs) const
-{
-    this->points.copy(IDs, points);
-    this->routes.copy(routes, costs);
-}
-
-void Graph::initialize(std::size_t srcID, std::size_t dstID)
-{
-    if (this->points.find(srcID) && this->points.find(dstID))
-    {
-        this->dstID = dstID;
-        this->nodes = Nodes(this->points, srcID, dstID);
-        this->scoreHeap.clear();
-        this->scoreHeap.push_back(
-            &this->nodes[this->nodes.find(srcID)]);
-        this->ready = true;
-    }
-    else
-    {
-        this->ready = false;
-        this->done = false;
-    }
-}
-
-void Graph::findPath()
-{
-    if (!this->ready)
-        return;
-
-    std::vector<std::size_t> dstIDs;
-
-    while (!this->scoreHeap.empty())
-    {
-        std::size_t currID = this->scoreHeap.front()->currID;
-        std::pop_heap(this->scoreHeap.begin(),
-                      this->scoreHeap.end(), Node::MinHeap());
-        this->scoreHeap.pop_back();
-
-        if (this->getScore(currID) >= this->getCosts(this->dstID))
-            break;
-
-        this->markID(currID);
-        this->routes.copy(dstIDs, currID);
-
-        for (std::size_t i = 0; i < dstIDs.size(); ++i)
-        {
-            this->update(currID, dstIDs[i]);
-
-            if (this->isNew(dstIDs[i]))
-            {
-                this->scoreHeap.push_back(
-                    &this->nodes[this->nodes.find(dstIDs[i])]);
-                this->markID(dstIDs[i]);
-            }
-        }
-
-        std::make_heap(this->scoreHeap.begin(),
-                       this->scoreHeap.end(), Node::MinHeap());
-    }
-
-    this->done = true;
-}
-
-std::size_t Graph::countPoints() const
-{
-    return this->points.size();
-}
-
-std::size_t Graph::countRoutes() const
-{
-    return this->routes.size();
-}
-
-std::vector<std::size_t> Graph::getPath() const
-{
-    std::vector<std::size_t> path;
-
-    if (this->done)
-    {
-        path.push_back(dstID);
-        std::size_t currID = this->dstID,
-                    prevID = this->getPrevID(currID);
-
-        while (prevID != (std::size_t)-1)
-        {
-            currID = prevID;
-            path.push_back(currID);
-            prevID = this->getPrevID(currID);
-        }
-
-        std::reverse(path.begin(), path.end());
-    }
-
-    return path;
-}
-
-double Graph::getCosts() const
-{
-    if (this->done)
-        return this->getCosts(this->dstID);
-    else
-        return -1;
+#include "graph.h"
+#include "metrics.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <ctime>
+#if __cplusplus >= 201103L
+#include <chrono>
+#endif
+
+
+static double now()
+{
+#if __cplusplus >= 201103L
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#elif defined(__unix__) || defined(__APPLE__)
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+#else
+    return (double)std::clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+
+Point::Point()
+{
+    this->unitX = this->unitY = this->unitZ = 0;
+}
+
+Point::Point(const Point &other)
+{
+    this->unitX = other.unitX;
+    this->unitY = other.unitY;
+    this->unitZ = other.unitZ;
+}
+
+Point::Point(double phi, double theta)
+{
+    this->unitX = std::sin(phi) * std::cos(theta);
+    this->unitY = std::sin(phi) * std::sin(theta);
+    this->unitZ = std::cos(phi);
+}
+
+double Point::operator*(const Point &other) const
+{
+    return this->unitX * other.unitX +
+           this->unitY * other.unitY +
+           this->unitZ * other.unitZ;
+}
+
+double Point::operator^(const Point &other) const
+{
+    return std::acos(*this * other);
+}
+
+
+Route::Route(std::size_t srcID, std::size_t dstID)
+{
+    this->srcID = srcID;
+    this->dstID = dstID;
+}
+
+bool Route::operator<(const Route &other) const
+{
+    if (this->srcID != other.srcID)
+        return this->srcID < other.srcID;
+
+    if (this->dstID != other.dstID)
+        return this->dstID < other.dstID;
+
+    return false;
+}
+
+bool Route::OrderByDstID::operator()(const Route &a,
+                                     const Route &b) const
+{
+    if (a.dstID != b.dstID)
+        return a.dstID < b.dstID;
+
+    if (a.srcID != b.srcID)
+        return a.srcID < b.srcID;
+
+    return false;
+}
+
+
+Node::Node(std::size_t currID)
+{
+    this->currID = currID;
+    this->prevID = -1;
+    this->found = false;
+    this->closed = false;
+    this->costs = std::numeric_limits<double>::infinity();
+    this->bound = 0;
+    this->score = std::numeric_limits<double>::infinity();
+}
+
+bool Node::operator<(const Node &other) const
+{
+    return this->currID < other.currID;
+}
+
+bool Node::MinHeap::operator()(const Node *a,
+                               const Node *b) const
+{
+    return a->score > b->score;
+}
+
+
+Limits::Limits()
+{
+    this->seconds = std::numeric_limits<double>::infinity();
+    this->expansions = -1;
+    this->bytes = -1;
+    this->cancel = NULL;
+}
+
+
+Points::Points()
+{
+}
+
+Point Points::operator[](std::size_t ID) const
+{
+    return this->points.find(ID)->second;
+}
+
+void Points::insert(std::size_t ID,
+                    double phi, double theta)
+{
+    this->points[ID] = Point(phi, theta);
+}
+
+void Points::erase(std::size_t ID)
+{
+    this->points.erase(ID);
+}
+
+void Points::clear()
+{
+    this->points.clear();
+}
+
+void Points::copy(std::vector<Node> &nodes) const
+{
+    nodes.reserve(this->points.size());
+    std::map<std::size_t, Point>::const_iterator
+        const_lower = this->points.begin(),
+        const_upper = this->points.end(),
+        const_iter;
+
+    for (const_iter = const_lower;
+         const_iter != const_upper; ++const_iter)
+        nodes.push_back(Node(const_iter->first));
+}
+
+void Points::copy(std::vector<std::size_t> &IDs,
+                  std::vector<Point> &points) const
+{
+    IDs.reserve(this->points.size());
+    points.reserve(this->points.size());
+    std::map<std::size_t, Point>::const_iterator
+        const_lower = this->points.begin(),
+        const_upper = this->points.end(),
+        const_iter;
+
+    for (const_iter = const_lower;
+         const_iter != const_upper; ++const_iter)
+    {
+        IDs.push_back(const_iter->first);
+        points.push_back(const_iter->second);
+    }
+}
+
+bool Points::find(std::size_t ID) const
+{
+    return this->points.find(ID) != this->points.end();
+}
+
+std::size_t Points::size() const
+{
+    return this->points.size();
+}
+
+
+Routes::Routes()
+{
+}
+
+double Routes::operator[](const Route &route) const
+{
+    return this->routesBySrcID.find(route)->second;
+}
+
+void Routes::insert(std::size_t srcID, std::size_t dstID,
+                    double cost)
+{
+    Route route(srcID, dstID);
+    this->routesBySrcID[route] = cost;
+    this->routesByDstID[route] = cost;
+}
+
+void Routes::erase(std::size_t srcID, std::size_t dstID)
+{
+    Route route(srcID, dstID);
+    this->routesBySrcID.erase(route);
+    this->routesByDstID.erase(route);
+}
+
+void Routes::erase(std::size_t ID)
+{
+    std::map<Route, double>::iterator
+        lowerSrc = this->routesBySrcID.lower_bound(Route(ID, 0)),
+        upperSrc = this->routesBySrcID.upper_bound(Route(ID, -1)),
+        iterSrc = lowerSrc;
+
+    while (iterSrc != upperSrc)
+    {
+        this->routesByDstID.erase(iterSrc->first);
+        this->routesBySrcID.erase(iterSrc++);
+    }
+
+    std::map<Route, double, Route::OrderByDstID>::iterator
+        lowerDst = this->routesByDstID.lower_bound(Route(0, ID)),
+        upperDst = this->routesByDstID.upper_bound(Route(-1, ID)),
+        iterDst = lowerDst;
+
+    while (iterDst != upperDst)
+    {
+        this->routesBySrcID.erase(iterDst->first);
+        this->routesByDstID.erase(iterDst++);
+    }
+}
+
+void Routes::clear()
+{
+    this->routesBySrcID.clear();
+    this->routesByDstID.clear();
+}
+
+void Routes::copy(std::vector<std::size_t> &dstIDs,
+                  std::size_t srcID) const
+{
+    dstIDs.clear();
+    std::map<Route, double>::const_iterator
+        const_lower = this->routesBySrcID.lower_bound(Route(srcID, 0)),
+        const_upper = this->routesBySrcID.upper_bound(Route(srcID, -1)),
+        const_iter;
+
+    for (const_iter = const_lower;
+         const_iter != const_upper; ++const_iter)
+        dstIDs.push_back(const_iter->first.dstID);
+}
+
+void Routes::copy(std::vector<std::size_t> &srcIDs,
+                  std::vector<double> &costs,
+                  std::size_t dstID) const
+{
+    srcIDs.clear();
+    costs.clear();
+    std::map<Route, double, Route::OrderByDstID>::const_iterator
+        const_lower = this->routesByDstID.lower_bound(Route(0, dstID)),
+        const_upper = this->routesByDstID.upper_bound(Route(-1, dstID)),
+        const_iter;
+
+    for (const_iter = const_lower;
+         const_iter != const_upper; ++const_iter)
+    {
+        srcIDs.push_back(const_iter->first.srcID);
+        costs.push_back(const_iter->second);
+    }
+}
+
+void Routes::copy(std::vector<Route> &routes,
+                  std::vector<double> &costs) const
+{
+    routes.reserve(this->routesBySrcID.size());
+    costs.reserve(this->routesBySrcID.size());
+    std::map<Route, double>::const_iterator
+        const_lower = this->routesBySrcID.begin(),
+        const_upper = this->routesBySrcID.end(),
+        const_iter;
+
+    for (const_iter = const_lower;
+         const_iter != const_upper; ++const_iter)
+    {
+        routes.push_back(const_iter->first);
+        costs.push_back(const_iter->second);
+    }
+}
+
+bool Routes::find(const Route &route) const
+{
+    return this->routesBySrcID.find(route) != this->routesBySrcID.end();
+}
+
+std::size_t Routes::size() const
+{
+    return this->routesBySrcID.size();
+}
+
+
+Nodes::Nodes()
+{
+    this->points = NULL;
+    this->IDs = NULL;
+    this->bounds = NULL;
+    this->weight = 0;
+}
+
+Nodes::Nodes(const Points &points,
+             std::size_t srcID, std::size_t dstID,
+             double weight)
+{
+    this->points = &points;
+    this->IDs = NULL;
+    this->bounds = NULL;
+    this->dstPoint = points[dstID];
+    this->weight = weight;
+    (*this)[srcID].costs = 0;
+}
+
+Nodes::Nodes(const std::vector<std::size_t> &IDs, std::size_t srcID,
+             const std::vector<double> &bounds)
+{
+    this->points = NULL;
+    this->IDs = &IDs;
+    this->bounds = &bounds;
+    this->weight = 0;
+    (*this)[srcID].costs = 0;
+}
+
+Node &Nodes::operator[](std::size_t ID)
+{
+    std::map<std::size_t, Node>::iterator iter = this->nodes.find(ID);
+
+    if (iter != this->nodes.end())
+        return iter->second;
+
+    Node node(ID);
+
+    if (this->bounds)
+        node.bound = (*this->bounds)[std::lower_bound(this->IDs->begin(),
+                                                      this->IDs->end(), ID) -
+                                     this->IDs->begin()];
+    else
+        node.bound = this->weight * ((*this->points)[ID] ^ this->dstPoint);
+
+    return this->nodes.insert(std::make_pair(ID, node)).first->second;
+}
+
+Node Nodes::operator[](std::size_t ID) const
+{
+    std::map<std::size_t, Node>::const_iterator const_iter =
+        this->nodes.find(ID);
+
+    if (const_iter != this->nodes.end())
+        return const_iter->second;
+
+    return Node(ID);
+}
+
+void Nodes::clear()
+{
+    this->nodes.clear();
+}
+
+void Nodes::inflate(double epsilon)
+{
+    std::map<std::size_t, Node>::iterator
+        lower = this->nodes.begin(),
+        upper = this->nodes.end(),
+        iter;
+
+    for (iter = lower; iter != upper; ++iter)
+    {
+        Node &node = iter->second;
+        node.closed = false;
+        node.score = node.costs + (1 + epsilon) * node.bound;
+    }
+}
+
+std::size_t Nodes::size() const
+{
+    return this->nodes.size();
+}
+
+std::size_t Nodes::countBytes() const
+{
+    return this->nodes.size() *
+           (sizeof(std::pair<const std::size_t, Node>) +
+            4 * sizeof(void *));
+}
+
+
+bool Graph::update(std::size_t currID, std::size_t nextID)
+{
+    double costs = this->getCosts(currID) +
+                   this->routes[Route(currID, nextID)];
+    Node &nextNode = this->nodes[nextID];
+
+    if (costs < nextNode.costs)
+    {
+        nextNode.prevID = currID;
+        nextNode.costs = costs;
+        nextNode.score = costs + (1 + this->epsilon) * nextNode.bound;
+
+        return true;
+    }
+
+    return false;
+}
+
+bool Graph::check(std::size_t srcID, std::size_t dstID,
+                  double cost) const
+{
+    if (srcID == dstID)
+        throw INVALID_ROUTE_1;
+
+    Point srcPoint = this->points[srcID],
+          dstPoint = this->points[dstID];
+
+    if (cost < this->weight * (srcPoint ^ dstPoint))
+        throw INVALID_ROUTE_2;
+
+    return true;
+}
+
+std::size_t Graph::getPrevID(std::size_t ID) const
+{
+    if (!this->linked)
+        return -1;
+
+    return this->nodes[ID].prevID;
+}
+
+double Graph::getCosts(std::size_t ID) const
+{
+    if (!this->linked)
+        return std::numeric_limits<double>::infinity();
+
+    return this->nodes[ID].costs;
+}
+
+double Graph::getScore(std::size_t ID) const
+{
+    return this->nodes[ID].score;
+}
+
+void Graph::inflate(double epsilon)
+{
+    this->epsilon = epsilon;
+    this->scoreHeap.insert(this->scoreHeap.end(),
+                           this->inconsList.begin(),
+                           this->inconsList.end());
+    this->inconsList.clear();
+    this->nodes.inflate(epsilon);
+    std::make_heap(this->scoreHeap.begin(),
+                   this->scoreHeap.end(), Node::MinHeap());
+}
+
+bool Graph::exceeds() const
+{
+    if (this->expanded >= this->limits.expansions)
+        return true;
+
+    if (this->limits.cancel && *this->limits.cancel)
+        return true;
+
+    if ((this->expanded & 63) == 0)
+    {
+        if (now() - this->start >= this->limits.seconds)
+            return true;
+
+        std::size_t bytes =
+            this->nodes.countBytes() +
+            (this->scoreHeap.capacity() +
+             this->inconsList.capacity()) *
+                sizeof(const Node *);
+
+        if (bytes > this->limits.bytes)
+            return true;
+    }
+
+    return false;
+}
+
+void Graph::search()
+{
+    std::vector<std::size_t> dstIDs;
+    this->status = PATH_NOT_FOUND;
+    this->lastID = this->dstID;
+
+    while (!this->scoreHeap.empty())
+    {
+        std::size_t currID = this->scoreHeap.front()->currID;
+
+        if (this->getScore(currID) >= this->getCosts(this->dstID))
+            break;
+
+        if (this->exceeds())
+        {
+            this->status = PATH_CUT_OFF;
+
+            if (this->getCosts(this->dstID) ==
+                std::numeric_limits<double>::infinity())
+                this->lastID = currID;
+
+            return;
+        }
+
+        ++this->expanded;
+
+        std::pop_heap(this->scoreHeap.begin(),
+                      this->scoreHeap.end(), Node::MinHeap());
+        this->scoreHeap.pop_back();
+        Node &currNode = this->nodes[currID];
+        currNode.found = false;
+        currNode.closed = true;
+        this->routes.copy(dstIDs, currID);
+
+        for (std::size_t i = 0; i < dstIDs.size(); ++i)
+        {
+            if (!this->update(currID, dstIDs[i]) ||
+                dstIDs[i] == this->dstID)
+                continue;
+
+            Node &nextNode = this->nodes[dstIDs[i]];
+
+            if (nextNode.found)
+                continue;
+
+            nextNode.found = true;
+
+            if (nextNode.closed && this->epsilon > 0)
+                this->inconsList.push_back(&nextNode);
+            else
+                this->scoreHeap.push_back(&nextNode);
+        }
+
+        std::make_heap(this->scoreHeap.begin(),
+                       this->scoreHeap.end(), Node::MinHeap());
+    }
+
+    if (this->getCosts(this->dstID) <
+        std::numeric_limits<double>::infinity())
+        this->status = PATH_FOUND;
+}
+
+void Graph::measure()
+{
+    double costs = this->getCosts(this->dstID),
+           lowest = std::numeric_limits<double>::infinity();
+
+    for (std::size_t i = 0; i < this->scoreHeap.size(); ++i)
+        lowest = std::min(lowest, this->scoreHeap[i]->costs +
+                                      this->scoreHeap[i]->bound);
+
+    for (std::size_t i = 0; i < this->inconsList.size(); ++i)
+        lowest = std::min(lowest, this->inconsList[i]->costs +
+                                      this->inconsList[i]->bound);
+
+    if (lowest >= costs)
+        this->bound = 1;
+    else if (lowest > 0)
+        this->bound = std::min(1 + this->epsilon, costs / lowest);
+    else
+        this->bound = 1 + this->epsilon;
+}
+
+Graph::Graph(double weight)
+{
+    this->ready = false;
+    this->done = false;
+    this->linked = true;
+    this->weight = weight;
+    this->epsilon = 0;
+    this->bound = 1;
+    this->status = PATH_NOT_FOUND;
+    this->expanded = 0;
+    this->version = 0;
+    this->ranked = -1;
+    this->start = 0;
+}
+
+void Graph::updateWeight(double weight)
+{
+    if (weight < 0)
+        throw NEGATIVE_WEIGHT;
+
+    ++this->version;
+
+    if (weight > this->weight)
+    {
+        this->weight = weight;
+        this->routes.clear();
+        this->components.invalidate();
+
+        throw INCREASED_WEIGHT;
+    }
+
+    this->weight = weight;
+}
+
+void Graph::updateLimits(const Limits &limits)
+{
+    this->limits = limits;
+}
+
+void Graph::insertPoint(std::size_t ID,
+                        double phi, double theta)
+{
+    this->points.insert(ID, phi, theta);
+    this->components.insertPoint(ID);
+    ++this->version;
+}
+
+void Graph::erasePoint(std::size_t ID)
+{
+    this->points.erase(ID);
+    this->routes.erase(ID);
+    this->components.invalidate();
+    ++this->version;
+    this->ready = false;
+    this->done = false;
+}
+
+void Graph::clearPoints()
+{
+    this->points.clear();
+    this->routes.clear();
+    this->components.invalidate();
+    ++this->version;
+    this->ready = false;
+    this->done = false;
+}
+
+void Graph::insertRoute(std::size_t srcID, std::size_t dstID,
+                        double cost)
+{
+    if (this->points.find(srcID) && this->points.find(dstID) &&
+        this->check(srcID, dstID, cost))
+    {
+        this->routes.insert(srcID, dstID, cost);
+        this->components.insertRoute(srcID, dstID);
+        ++this->version;
+        this->ready = false;
+        this->done = false;
+    }
+}
+
+void Graph::eraseRoute(std::size_t srcID, std::size_t dstID)
+{
+    this->routes.erase(srcID, dstID);
+    this->components.invalidate();
+    ++this->version;
+    this->ready = false;
+    this->done = false;
+}
+
+void Graph::clearRoutes()
+{
+    this->routes.clear();
+    this->components.invalidate();
+    ++this->version;
+    this->ready = false;
+    this->done = false;
+}
+
+void Graph::insertDestination(std::size_t ID)
+{
+    this->destinations.insert(ID);
+}
+
+void Graph::eraseDestination(std::size_t ID)
+{
+    this->destinations.erase(ID);
+}
+
+void Graph::clearDestinations()
+{
+    this->destinations.clear();
+}
+
+void Graph::updateBudget(std::size_t bytes, bool compressed)
+{
+    this->destinations.updateBudget(bytes, compressed);
+}
+
+void Graph::copy(std::vector<std::size_t> &IDs,
+                 std::vector<Point> &points,
+                 std::vector<Route> &routes,
+                 std::vector<double> &costs) const
+{
+    this->points.copy(IDs, points);
+    this->routes.copy(routes, costs);
+}
+
+void Graph::initialize(std::size_t srcID, std::size_t dstID)
+{
+    Timer timer(TIMER_INITIALIZE);
+    Metrics::update(COUNTER_VERSION, this->version);
+
+    if (this->points.find(srcID) && this->points.find(dstID))
+    {
+        this->start = now();
+        this->expanded = 0;
+        this->dstID = dstID;
+        this->lastID = dstID;
+        this->ready = true;
+        this->linked = this->components.reaches(this->points,
+                                                this->routes,
+                                                srcID, dstID);
+        this->scoreHeap.clear();
+        this->inconsList.clear();
+        this->nodes.clear();
+
+        if (this->limits.bytes != (std::size_t)-1)
+        {
+            std::vector<const Node *>().swap(this->scoreHeap);
+            std::vector<const Node *>().swap(this->inconsList);
+        }
+
+        if (!this->linked)
+            return;
+
+        if (this->destinations.copy(this->points, this->routes,
+                                    this->version, dstID, this->bounds))
+        {
+            if (this->ranked != this->version)
+            {
+                std::vector<Point> coords;
+                this->IDs.clear();
+                this->points.copy(this->IDs, coords);
+                this->ranked = this->version;
+            }
+
+            this->nodes = Nodes(this->IDs, srcID, this->bounds);
+        }
+        else
+            this->nodes = Nodes(this->points, srcID, dstID,
+                                this->weight);
+
+        Node &srcNode = this->nodes[srcID];
+        srcNode.found = true;
+        this->scoreHeap.push_back(&srcNode);
+    }
+    else
+    {
+        this->ready = false;
+        this->done = false;
+        this->status = PATH_NOT_FOUND;
+    }
+}
+
+void Graph::findPath()
+{
+    this->findPath(0);
+}
+
+void Graph::findPath(double epsilon)
+{
+    Timer timer(TIMER_FIND_PATH);
+    this->run(epsilon);
+}
+
+void Graph::run(double epsilon)
+{
+    if (epsilon < 0)
+        throw NEGATIVE_EPSILON;
+
+    if (!this->ready)
+        return;
+
+    if (!this->linked)
+    {
+        this->status = PATH_NOT_FOUND;
+        this->bound = 1;
+        this->done = true;
+        return;
+    }
+
+    this->inflate(epsilon);
+    this->search();
+    this->measure();
+    this->done = true;
+}
+
+void Graph::findPath(double epsilon, double seconds)
+{
+    Timer timer(TIMER_FIND_PATH);
+
+    if (epsilon < 0)
+        throw NEGATIVE_EPSILON;
+
+    double limit = this->limits.seconds;
+    this->limits.seconds = std::min(limit, now() - this->start + seconds);
+    this->run(epsilon);
+
+    while (this->done && this->status == PATH_FOUND && this->bound > 1)
+    {
+        double bound = this->bound;
+        epsilon = std::min(this->epsilon / 2, this->bound - 1);
+
+        if (epsilon < 0.001)
+            epsilon = 0;
+
+        this->inflate(epsilon);
+        this->search();
+
+        if (this->status == PATH_CUT_OFF)
+        {
+            this->status = PATH_FOUND;
+            this->bound = bound;
+            break;
+        }
+
+        this->measure();
+    }
+
+    this->limits.seconds = limit;
+}
+
+std::size_t Graph::countPoints() const
+{
+    return this->points.size();
+}
+
+std::size_t Graph::countRoutes() const
+{
+    return this->routes.size();
+}
+
+std::size_t Graph::getVersion() const
+{
+    return this->version;
+}
+
+const Destinations &Graph::getDestinations() const
+{
+    return this->destinations;
+}
+
+double Graph::getWeight() const
+{
+    return this->weight;
+}
+
+double Graph::getCost(std::size_t srcID, std::size_t dstID) const
+{
+    if (this->routes.find(Route(srcID, dstID)))
+        return this->routes[Route(srcID, dstID)];
+    else
+        return std::numeric_limits<double>::infinity();
+}
+
+std::vector<std::size_t> Graph::getPath(std::size_t ID) const
+{
+    std::vector<std::size_t> path;
+
+    if (this->done)
+    {
+        path.push_back(ID);
+        std::size_t currID = ID,
+                    prevID = this->getPrevID(currID);
+
+        while (prevID != (std::size_t)-1)
+        {
+            currID = prevID;
+            path.push_back(currID);
+            prevID = this->getPrevID(currID);
+        }
+
+        std::reverse(path.begin(), path.end());
+    }
+
+    return path;
+}
+
+std::vector<std::size_t> Graph::getPath() const
+{
+    return this->getPath(this->dstID);
+}
+
+double Graph::getCosts() const
+{
+    if (this->done)
+        return this->getCosts(this->dstID);
+    else
+        return -1;
+}
+
+std::vector<std::size_t> Graph::getPartialPath() const
+{
+    return this->getPath(this->lastID);
+}
+
+double Graph::getPartialCosts() const
+{
+    if (this->done)
+        return this->getCosts(this->lastID);
+    else
+        return -1;
+}
+
+double Graph::getBound() const
+{
+    if (this->done)
+        return this->bound;
+    else
+        return -1;
+}
+
+int Graph::getStatus() const
+{
+    return this->status;
+}
+
+std::size_t Graph::countExpanded() const
+{
+    return this->expanded;
+}
+
+std::vector<std::size_t> Graph::getFrontier() const
+{
+    std::vector<const Node *> scoreHeap = this->scoreHeap;
+    std::vector<std::size_t> frontier;
+    frontier.reserve(scoreHeap.size());
+
+    if (this->done)
+        while (!scoreHeap.empty())
+        {
+            frontier.push_back(scoreHeap.front()->currID);
+            std::pop_heap(scoreHeap.begin(),
+                          scoreHeap.end(), Node::MinHeap());
+            scoreHeap.pop_back();
+        }
+
+    return frontier;
 }
\ No newline at end of file
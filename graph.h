@@ -1,184 +1,273 @@
-#ifndef GRAPH_H
-#define GRAPH_H
-
-#include <map>
-#include <vector>
-
-
-#ifndef INVALID_ROUTE_1
-#define INVALID_ROUTE_1 11
-#endif
-
-#ifndef INVALID_ROUTE_2
-#define INVALID_ROUTE_2 12
-#endif
-
-#ifndef NEGATIVE_WEIGHT
-#define NEGATIVE_WEIGHT 21
-#endif
-
-#ifndef INCREASED_WEIGHT
-#define INCREASED_WEIGHT 22
-#endif
-
-
-struct Point
-{
-    double unitX;
-    double unitY;
-    double unitZ;
-
-    Point();
-    Point(const Point &);
-    Point(double, double);
-
-    double operator*(const Point &) const;
-    double operator^(const Point &) const;
-};
-
-
-struct Route
-{
-    std::size_t srcID;
-    std::size_t dstID;
-
-    Route(std::size_t, std::size_t);
-
-    bool operator<(const Route &) const;
-    struct OrderByDstID
-    {
-        bool operator()(const Route &,
-                        const Route &) const;
-    };
-};
-
-
-struct Node
-{
-    std::size_t currID;
-    std::size_t prevID;
-    bool found;
-    double costs;
-    double angle;
-    double score;
-
-    Node(std::size_t);
-
-    bool operator<(const Node &) const;
-    struct MinHeap
-    {
-        bool operator()(const Node *,
-                        const Node *) const;
-    };
-};
-
-
-class Points
-{
-    std::map<std::size_t, Point> points;
-
-public:
-    Points();
-
-    Point operator[](std::size_t) const;
-
-    void insert(std::size_t,
-                double, double);
-    void erase(std::size_t);
-    void clear();
-    void copy(std::vector<Node> &) const;
-    void copy(std::vector<std::size_t> &,
-              std::vector<Point> &) const;
-    bool find(std::size_t) const;
-    std::size_t size() const;
-};
-
-
-class Routes
-{
-    std::map<Route, double> routesBySrcID;
-    std::map<Route, double,
-             Route::OrderByDstID>
-        routesByDstID;
-
-public:
-    Routes();
-
-    double operator[](const Route &) const;
-
-    void insert(std::size_t, std::size_t,
-                double);
-    void erase(std::size_t, std::size_t);
-    void erase(std::size_t);
-    void clear();
-    void copy(std::vector<std::size_t> &,
-              std::size_t) const;
-    void copy(std::vector<Route> &,
-              std::vector<double> &) const;
-    std::size_t size() const;
-};
-
-
-class Nodes
-{
-    std::vector<Node> nodes;
-
-public:
-    Nodes();
-    Nodes(const Points &,
-          std::size_t, std::size_t);
-
-    Node &operator[](std::size_t);
-    Node operator[](std::size_t) const;
-
-    void clear();
-    std::size_t size() const;
-    std::size_t find(std::size_t) const;
-};
-
-
-class Graph
-{
-    bool ready;
-    bool done;
-    double weight;
-    std::size_t dstID;
-    Points points;
-    Routes routes;
-    Nodes nodes;
-    std::vector<const Node *> scoreHeap;
-
-    void markID(std::size_t);
-    void update(std::size_t, std::size_t);
-    bool check(std::size_t, std::size_t) const;
-    bool isNew(std::size_t) const;
-    std::size_t getPrevID(std::size_t) const;
-    double getCosts(std::size_t) const;
-    double getScore(std::size_t) const;
-
-public:
-    Graph(double);
-
-    void updateWeight(double);
-    void insertPoint(std::size_t,
-                     double, double);
-    void erasePoint(std::size_t);
-    void clearPoints();
-    void insertRoute(std::size_t, std::size_t,
-                     double);
-    void eraseRoute(std::size_t, std::size_t);
-    void clearRoutes();
-    void copy(std::vector<std::size_t> &,
-              std::vector<Point> &,
-              std::vector<Route> &,
-              std::vector<double> &) const;
-    void initialize(std::size_t, std::size_t);
-    void findPath();
-    std::size_t countPoints() const;
-    std::size_t countRoutes() const;
-    std::vector<std::size_t> getPath() const;
-    double getCosts() const;
-};
-
-
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include "component.h"
+#include "destination.h"
+#include <map>
+#include <vector>
+#if __cplusplus >= 201103L
+#include <atomic>
+#endif
+
+
+#ifndef INVALID_ROUTE_1
+#define INVALID_ROUTE_1 11
+#endif
+
+#ifndef INVALID_ROUTE_2
+#define INVALID_ROUTE_2 12
+#endif
+
+#ifndef NEGATIVE_WEIGHT
+#define NEGATIVE_WEIGHT 21
+#endif
+
+#ifndef INCREASED_WEIGHT
+#define INCREASED_WEIGHT 22
+#endif
+
+#ifndef NEGATIVE_EPSILON
+#define NEGATIVE_EPSILON 23
+#endif
+
+#ifndef PATH_FOUND
+#define PATH_FOUND 31
+#endif
+
+#ifndef PATH_NOT_FOUND
+#define PATH_NOT_FOUND 32
+#endif
+
+#ifndef PATH_CUT_OFF
+#define PATH_CUT_OFF 33
+#endif
+
+
+#if __cplusplus >= 201103L
+typedef std::atomic<bool> CancelFlag;
+#else
+typedef volatile bool CancelFlag;
+#endif
+
+
+struct Point
+{
+    double unitX;
+    double unitY;
+    double unitZ;
+
+    Point();
+    Point(const Point &);
+    Point(double, double);
+
+    double operator*(const Point &) const;
+    double operator^(const Point &) const;
+};
+
+
+struct Route
+{
+    std::size_t srcID;
+    std::size_t dstID;
+
+    Route(std::size_t, std::size_t);
+
+    bool operator<(const Route &) const;
+    struct OrderByDstID
+    {
+        bool operator()(const Route &,
+                        const Route &) const;
+    };
+};
+
+
+struct Node
+{
+    std::size_t currID;
+    std::size_t prevID;
+    bool found;
+    bool closed;
+    double costs;
+    double bound;
+    double score;
+
+    Node(std::size_t);
+
+    bool operator<(const Node &) const;
+    struct MinHeap
+    {
+        bool operator()(const Node *,
+                        const Node *) const;
+    };
+};
+
+
+struct Limits
+{
+    double seconds;
+    std::size_t expansions;
+    std::size_t bytes;
+    const CancelFlag *cancel;
+
+    Limits();
+};
+
+
+class Points
+{
+    std::map<std::size_t, Point> points;
+
+public:
+    Points();
+
+    Point operator[](std::size_t) const;
+
+    void insert(std::size_t,
+                double, double);
+    void erase(std::size_t);
+    void clear();
+    void copy(std::vector<Node> &) const;
+    void copy(std::vector<std::size_t> &,
+              std::vector<Point> &) const;
+    bool find(std::size_t) const;
+    std::size_t size() const;
+};
+
+
+class Routes
+{
+    std::map<Route, double> routesBySrcID;
+    std::map<Route, double,
+             Route::OrderByDstID>
+        routesByDstID;
+
+public:
+    Routes();
+
+    double operator[](const Route &) const;
+
+    void insert(std::size_t, std::size_t,
+                double);
+    void erase(std::size_t, std::size_t);
+    void erase(std::size_t);
+    void clear();
+    void copy(std::vector<std::size_t> &,
+              std::size_t) const;
+    void copy(std::vector<std::size_t> &,
+              std::vector<double> &,
+              std::size_t) const;
+    void copy(std::vector<Route> &,
+              std::vector<double> &) const;
+    bool find(const Route &) const;
+    std::size_t size() const;
+};
+
+
+class Nodes
+{
+    std::map<std::size_t, Node> nodes;
+    const Points *points;
+    const std::vector<std::size_t> *IDs;
+    const std::vector<double> *bounds;
+    Point dstPoint;
+    double weight;
+
+public:
+    Nodes();
+    Nodes(const Points &,
+          std::size_t, std::size_t,
+          double);
+    Nodes(const std::vector<std::size_t> &, std::size_t,
+          const std::vector<double> &);
+
+    Node &operator[](std::size_t);
+    Node operator[](std::size_t) const;
+
+    void clear();
+    void inflate(double);
+    std::size_t size() const;
+    std::size_t countBytes() const;
+};
+
+
+class Graph
+{
+    bool ready;
+    bool done;
+    bool linked;
+    double weight;
+    double epsilon;
+    double bound;
+    double start;
+    int status;
+    std::size_t dstID;
+    std::size_t lastID;
+    std::size_t expanded;
+    std::size_t version;
+    std::size_t ranked;
+    Limits limits;
+    Points points;
+    Routes routes;
+    Components components;
+    Destinations destinations;
+    Nodes nodes;
+    std::vector<std::size_t> IDs;
+    std::vector<double> bounds;
+    std::vector<const Node *> scoreHeap;
+    std::vector<const Node *> inconsList;
+
+    bool update(std::size_t, std::size_t);
+    bool check(std::size_t, std::size_t, double) const;
+    std::size_t getPrevID(std::size_t) const;
+    std::vector<std::size_t> getPath(std::size_t) const;
+    double getCosts(std::size_t) const;
+    double getScore(std::size_t) const;
+    void inflate(double);
+    bool exceeds() const;
+    void search();
+    void measure();
+    void run(double);
+
+public:
+    Graph(double);
+
+    void updateWeight(double);
+    void updateLimits(const Limits &);
+    void insertPoint(std::size_t,
+                     double, double);
+    void erasePoint(std::size_t);
+    void clearPoints();
+    void insertRoute(std::size_t, std::size_t,
+                     double);
+    void eraseRoute(std::size_t, std::size_t);
+    void clearRoutes();
+    void insertDestination(std::size_t);
+    void eraseDestination(std::size_t);
+    void clearDestinations();
+    void updateBudget(std::size_t, bool = false);
+    void copy(std::vector<std::size_t> &,
+              std::vector<Point> &,
+              std::vector<Route> &,
+              std::vector<double> &) const;
+    void initialize(std::size_t, std::size_t);
+    void findPath();
+    void findPath(double);
+    void findPath(double, double);
+    std::size_t countPoints() const;
+    std::size_t countRoutes() const;
+    std::size_t getVersion() const;
+    const Destinations &getDestinations() const;
+    double getWeight() const;
+    double getCost(std::size_t, std::size_t) const;
+    std::vector<std::size_t> getPath() const;
+    double getCosts() const;
+    std::vector<std::size_t> getPartialPath() const;
+    double getPartialCosts() const;
+    double getBound() const;
+    int getStatus() const;
+    std::size_t countExpanded() const;
+    std::vector<std::size_t> getFrontier() const;
+};
+
+
 #endif
\ No newline at end of file
@@ -0,0 +1,441 @@
+#ifndef KERNEL_H
+#define KERNEL_H
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+
+template <class Cost>
+struct Traits
+{
+    static Cost infinity() { return std::numeric_limits<Cost>::infinity(); }
+    static Cost fromCost(double cost) { return (Cost)cost; }
+    static Cost fromBound(double bound) { return (Cost)bound; }
+    static double toCost(Cost cost) { return cost; }
+};
+
+template <>
+struct Traits<float>
+{
+    static float infinity() { return std::numeric_limits<float>::infinity(); }
+    static float fromCost(double cost) { return (float)cost; }
+    static float fromBound(double bound) { return (float)(bound * 0.9999); }
+    static double toCost(float cost) { return cost; }
+};
+
+template <>
+struct Traits<std::size_t>
+{
+    static std::size_t infinity() { return -1; }
+    static double scale() { return 1048576.0; }
+
+    static std::size_t fromCost(double cost)
+    {
+        return (std::size_t)std::ceil(cost * scale());
+    }
+
+    static std::size_t fromBound(double bound)
+    {
+        if (bound == std::numeric_limits<double>::infinity())
+            return infinity();
+
+        return (std::size_t)std::floor(bound * scale());
+    }
+
+    static double toCost(std::size_t cost)
+    {
+        if (cost == infinity())
+            return std::numeric_limits<double>::infinity();
+
+        return cost / scale();
+    }
+};
+
+
+template <class Cost>
+struct Workspace
+{
+    unsigned stamp;
+    std::vector<unsigned> stamps;
+    std::vector<Cost> costs;
+    std::vector<Cost> bounds;
+    std::vector<std::size_t> prevs;
+
+    Workspace() : stamp(0) {}
+
+    void reset(std::size_t size)
+    {
+        if (this->stamps.size() != size || ++this->stamp == 0)
+        {
+            this->stamps.assign(size, 0);
+            this->costs.resize(size);
+            this->bounds.resize(size);
+            this->prevs.resize(size);
+            this->stamp = 1;
+        }
+    }
+
+    bool seen(std::size_t v) const
+    {
+        return this->stamps[v] == this->stamp;
+    }
+
+    std::size_t find(std::size_t v) const
+    {
+        return v;
+    }
+
+    std::size_t insert(std::size_t v)
+    {
+        this->stamps[v] = this->stamp;
+        return v;
+    }
+
+    double getCosts(std::size_t v) const
+    {
+        if (!this->seen(v))
+            return std::numeric_limits<double>::infinity();
+
+        return Traits<Cost>::toCost(this->costs[v]);
+    }
+};
+
+template <class Cost>
+struct Visited
+{
+    std::size_t used;
+    std::vector<std::size_t> keys;
+    std::vector<Cost> costs;
+    std::vector<Cost> bounds;
+    std::vector<std::size_t> prevs;
+
+    Visited() { this->reset(0); }
+
+    void reset(std::size_t)
+    {
+        this->used = 0;
+        std::vector<std::size_t>(16, -1).swap(this->keys);
+        std::vector<Cost>(16).swap(this->costs);
+        std::vector<Cost>(16).swap(this->bounds);
+        std::vector<std::size_t>(16).swap(this->prevs);
+    }
+
+    std::size_t find(std::size_t v) const
+    {
+        std::size_t mask = this->keys.size() - 1,
+                    slot = (v * 2654435761u) & mask;
+
+        while (this->keys[slot] != v && this->keys[slot] != (std::size_t)-1)
+            slot = (slot + 1) & mask;
+
+        return slot;
+    }
+
+    bool seen(std::size_t v) const
+    {
+        return this->keys[this->find(v)] == v;
+    }
+
+    std::size_t insert(std::size_t v)
+    {
+        if (2 * (this->used + 1) > this->keys.size())
+            this->grow();
+
+        std::size_t slot = this->find(v);
+        this->keys[slot] = v;
+        ++this->used;
+
+        return slot;
+    }
+
+    void grow()
+    {
+        Visited<Cost> next;
+        std::size_t size = 2 * this->keys.size();
+        next.keys.assign(size, -1);
+        next.costs.resize(size);
+        next.bounds.resize(size);
+        next.prevs.resize(size);
+
+        for (std::size_t i = 0; i < this->keys.size(); ++i)
+            if (this->keys[i] != (std::size_t)-1)
+            {
+                std::size_t slot = next.find(this->keys[i]);
+                next.keys[slot] = this->keys[i];
+                next.costs[slot] = this->costs[i];
+                next.bounds[slot] = this->bounds[i];
+                next.prevs[slot] = this->prevs[i];
+            }
+
+        this->keys.swap(next.keys);
+        this->costs.swap(next.costs);
+        this->bounds.swap(next.bounds);
+        this->prevs.swap(next.prevs);
+    }
+
+    double getCosts(std::size_t v) const
+    {
+        if (!this->seen(v))
+            return std::numeric_limits<double>::infinity();
+
+        return Traits<Cost>::toCost(this->costs[this->find(v)]);
+    }
+
+    std::size_t countBytes() const
+    {
+        return this->keys.size() *
+               (2 * sizeof(std::size_t) + 2 * sizeof(Cost));
+    }
+};
+
+
+template <class Cost>
+class BinaryHeap
+{
+    typedef std::pair<Cost, std::size_t> Item;
+    std::vector<Item> items;
+
+public:
+    bool empty() const { return this->items.empty(); }
+    void clear() { this->items.clear(); }
+    const Item &top() const { return this->items.front(); }
+
+    void push(Cost key, std::size_t v)
+    {
+        this->items.push_back(Item(key, v));
+        std::push_heap(this->items.begin(), this->items.end(),
+                       std::greater<Item>());
+    }
+
+    void pop()
+    {
+        std::pop_heap(this->items.begin(), this->items.end(),
+                      std::greater<Item>());
+        this->items.pop_back();
+    }
+};
+
+template <class Cost>
+class QuadHeap
+{
+    typedef std::pair<Cost, std::size_t> Item;
+    std::vector<Item> items;
+
+public:
+    bool empty() const { return this->items.empty(); }
+    void clear() { this->items.clear(); }
+    const Item &top() const { return this->items.front(); }
+
+    void push(Cost key, std::size_t v)
+    {
+        std::size_t i = this->items.size();
+        this->items.push_back(Item(key, v));
+        Item item = this->items[i];
+
+        while (i && item < this->items[(i - 1) >> 2])
+        {
+            this->items[i] = this->items[(i - 1) >> 2];
+            i = (i - 1) >> 2;
+        }
+
+        this->items[i] = item;
+    }
+
+    void pop()
+    {
+        Item item = this->items.back();
+        this->items.pop_back();
+        std::size_t size = this->items.size(), i = 0;
+
+        if (!size)
+            return;
+
+        while (true)
+        {
+            std::size_t first = (i << 2) + 1, best = first;
+
+            if (first >= size)
+                break;
+
+            for (std::size_t c = first + 1; c < first + 4 && c < size; ++c)
+                if (this->items[c] < this->items[best])
+                    best = c;
+
+            if (!(this->items[best] < item))
+                break;
+
+            this->items[i] = this->items[best];
+            i = best;
+        }
+
+        this->items[i] = item;
+    }
+};
+
+
+template <class Graph_>
+struct Blind
+{
+    static const bool blind = true;
+
+    void reset(const Graph_ &, std::size_t) {}
+    double operator()(const Graph_ &, std::size_t) const { return 0; }
+};
+
+template <class Graph_>
+struct Spherical
+{
+    static const bool blind = false;
+    double weight;
+    double unitX, unitY, unitZ;
+
+    void reset(const Graph_ &graph, std::size_t dst)
+    {
+        this->weight = graph.getWeight();
+        this->unitX = graph.getPoint(dst).unitX;
+        this->unitY = graph.getPoint(dst).unitY;
+        this->unitZ = graph.getPoint(dst).unitZ;
+    }
+
+    double operator()(const Graph_ &graph, std::size_t v) const
+    {
+        double dot = graph.getPoint(v).unitX * this->unitX +
+                     graph.getPoint(v).unitY * this->unitY +
+                     graph.getPoint(v).unitZ * this->unitZ;
+
+        return this->weight * std::acos(std::max(-1.0, std::min(1.0, dot)));
+    }
+};
+
+template <class Graph_, class Table>
+struct Tabled
+{
+    static const bool blind = false;
+    const Table *table;
+    std::size_t dst;
+
+    Tabled(const Table *table = 0) : table(table), dst(0) {}
+
+    void reset(const Graph_ &, std::size_t dst)
+    {
+        this->dst = dst;
+    }
+
+    double operator()(const Graph_ &, std::size_t v) const
+    {
+        return this->table->bound(v, this->dst);
+    }
+};
+
+template <class Graph_>
+struct Custom
+{
+    static const bool blind = false;
+    double (*function)(std::size_t, std::size_t, void *);
+    void *context;
+    std::size_t dstID;
+
+    void reset(const Graph_ &graph, std::size_t dst)
+    {
+        this->dstID = graph.getID(dst);
+    }
+
+    double operator()(const Graph_ &graph, std::size_t v) const
+    {
+        return this->function(graph.getID(v), this->dstID,
+                              this->context);
+    }
+};
+
+
+struct StopAtTarget
+{
+    static const bool stop = true;
+};
+
+struct Exhaust
+{
+    static const bool stop = false;
+};
+
+
+template <class Graph_, class Heuristic, class Queue,
+          class Cost, class Termination, class Space>
+std::size_t solve(const Graph_ &graph, Heuristic &heuristic,
+                  Queue &queue, Space &space,
+                  std::size_t src, std::size_t dst)
+{
+    typedef Traits<Cost> C;
+    std::size_t expanded = 0, slot;
+    space.reset(graph.size());
+    queue.clear();
+    heuristic.reset(graph, dst);
+
+    slot = space.insert(src);
+    space.costs[slot] = 0;
+    space.prevs[slot] = -1;
+    space.bounds[slot] = Heuristic::blind
+                             ? 0
+                             : C::fromBound(heuristic(graph, src));
+
+    if (space.bounds[slot] == C::infinity())
+        return expanded;
+
+    queue.push(space.bounds[slot], src);
+
+    while (!queue.empty())
+    {
+        Cost key = queue.top().first;
+        std::size_t v = queue.top().second;
+        queue.pop();
+        slot = space.find(v);
+        Cost costs = space.costs[slot];
+
+        if (Heuristic::blind ? key > costs
+                             : key > costs + space.bounds[slot])
+            continue;
+
+        if (Termination::stop && v == dst)
+            break;
+
+        ++expanded;
+
+        for (typename Graph_::Arcs arcs(graph, v);
+             arcs.valid(); arcs.next())
+        {
+            std::size_t w = arcs.target();
+            Cost nextCosts = costs + C::fromCost(arcs.cost());
+
+            if (space.seen(w))
+                slot = space.find(w);
+            else
+            {
+                slot = space.insert(w);
+                space.costs[slot] = C::infinity();
+                space.bounds[slot] = Heuristic::blind
+                                         ? 0
+                                         : C::fromBound(heuristic(graph, w));
+            }
+
+            if (nextCosts < space.costs[slot])
+            {
+                space.costs[slot] = nextCosts;
+                space.prevs[slot] = v;
+
+                if (Heuristic::blind)
+                    queue.push(nextCosts, w);
+                else if (space.bounds[slot] != C::infinity())
+                    queue.push(nextCosts + space.bounds[slot], w);
+            }
+        }
+    }
+
+    return expanded;
+}
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "landmark.h"
+#include "stepping.h"
+#include <limits>
+#include <algorithm>
+
+
+Landmarks::Landmarks(const Snapshot &snapshot, std::size_t count)
+{
+    std::size_t size = snapshot.size();
+    double infinity = std::numeric_limits<double>::infinity();
+    Snapshot reversed = snapshot.reverse();
+    Stepping forward(snapshot), backward(reversed);
+    std::vector<double> nearest(size, infinity);
+
+    if (size)
+        forward.findCosts(snapshot.getID(0));
+
+    for (std::size_t l = 0; l < count && size; ++l)
+    {
+        const std::vector<double> &costs = forward.getCosts();
+        std::size_t far = 0;
+
+        for (std::size_t v = 0; v < size; ++v)
+        {
+            if (l && costs[v] < nearest[v])
+                nearest[v] = costs[v];
+
+            double reach = l ? nearest[v] : costs[v];
+
+            if (reach < infinity &&
+                reach > (l ? nearest[far] : costs[far]))
+                far = v;
+        }
+
+        if (std::find(this->indices.begin(), this->indices.end(),
+                      far) != this->indices.end())
+            break;
+
+        this->indices.push_back(far);
+        forward.findCosts(snapshot.getID(far));
+
+        if (!l)
+            nearest = forward.getCosts();
+    }
+
+    this->count = this->indices.size();
+    this->froms.assign(size * this->count, infinity);
+    this->tos.assign(size * this->count, infinity);
+
+    for (std::size_t l = 0; l < this->count; ++l)
+    {
+        forward.findCosts(snapshot.getID(this->indices[l]));
+        backward.findCosts(snapshot.getID(this->indices[l]));
+
+        for (std::size_t v = 0; v < size; ++v)
+        {
+            this->froms[v * this->count + l] = forward.getCosts()[v];
+            this->tos[v * this->count + l] = backward.getCosts()[v];
+        }
+    }
+}
+
+std::size_t Landmarks::size() const
+{
+    return this->count;
+}
+
+std::size_t Landmarks::getIndex(std::size_t l) const
+{
+    return this->indices[l];
+}
+
+double Landmarks::bound(std::size_t v, std::size_t dst) const
+{
+    double infinity = std::numeric_limits<double>::infinity(),
+           best = 0;
+    const double *fromV = &this->froms[v * this->count],
+                 *fromDst = &this->froms[dst * this->count],
+                 *toV = &this->tos[v * this->count],
+                 *toDst = &this->tos[dst * this->count];
+
+    for (std::size_t l = 0; l < this->count; ++l)
+    {
+        if (toDst[l] < infinity)
+            best = std::max(best, toV[l] - toDst[l]);
+
+        if (fromV[l] < infinity)
+            best = std::max(best, fromDst[l] - fromV[l]);
+    }
+
+    return best * (1 - 1e-9);
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef LANDMARK_H
+#define LANDMARK_H
+
+#include "snapshot.h"
+
+
+class Landmarks
+{
+    std::size_t count;
+    std::vector<std::size_t> indices;
+    std::vector<double> froms;
+    std::vector<double> tos;
+
+public:
+    Landmarks(const Snapshot &, std::size_t);
+
+    std::size_t size() const;
+    std::size_t getIndex(std::size_t) const;
+    double bound(std::size_t, std::size_t) const;
+};
+
+
+#endif
\ No newline at end of file
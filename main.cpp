@@ -1,139 +1,297 @@
-#include "graph.h"
-#include "file.h"
-#include <iostream>
-
-
-int main()
-{
-    std::cout << "Welcome to A-star Program!" << std::endl;
-    std::cout << "  Option 0: Exit" << std::endl;
-    std::cout << "  Option 1: Insert Points" << std::endl;
-    std::cout << "  Option 2: Erase Points" << std::endl;
-    std::cout << "  Option 3: Clear Points" << std::endl;
-    std::cout << "  Option 4: Insert Routes" << std::endl;
-    std::cout << "  Option 5: Erase Routes" << std::endl;
-    std::cout << "  Option 6: Clear Routes" << std::endl;
-    std::cout << "  Option 7: Find Shortest Path" << std::endl;
-    std::cout << "  Option 8: Update Weight" << std::endl;
-    std::cout << "  Option 9: Backup" << std::endl;
-
-    unsigned option = 0;
-    Graph graph(0);
-    std::string fileName;
-    std::size_t srcID, dstID;
-    double weight;
-
-    do
-    {
-        std::cout << std::endl
-                  << "Option> ";
-        std::cin >> option;
-
-        switch (option)
-        {
-        case 1:
-            std::cout << "  File Name: ", std::cin >> fileName;
-
-            try
-            {
-                insertPoints(fileName, graph);
-            }
-            catch (int e)
-            {
-                if (e == FILE_NOT_FOUND)
-                    std::cout << "ERROR - FILE NOT FOUND" << std::endl;
-            }
-
-            break;
-
-        case 2:
-            std::cout << "  File Name: ", std::cin >> fileName;
-
-            try
-            {
-                erasePoints(fileName, graph);
-            }
-            catch (int e)
-            {
-                if (e == FILE_NOT_FOUND)
-                    std::cout << "ERROR - FILE NOT FOUND" << std::endl;
-            }
-
-            break;
-
-        case 3:
-            graph.clearPoints();
-            break;
-
-        case 4:
-            std::cout << "  File Name: ", std::cin >> fileName;
-
-            try
-            {
-                insertRoutes(fileName, graph);
-            }
-            catch (int e)
-            {
-                if (e == FILE_NOT_FOUND)
-                    std::cout << "ERROR - FILE NOT FOUND" << std::endl;
-            }
-
-            break;
-
-        case 5:
-            std::cout << "  File Name: ", std::cin >> fileName;
-
-            try
-            {
-                eraseRoutes(fileName, graph);
-            }
-            catch (int e)
-            {
-                if (e == FILE_NOT_FOUND)
-                    std::cout << "ERROR - FILE NOT FOUND" << std::endl;
-            }
-
-            break;
-
-        case 6:
-            graph.clearRoutes();
-            break;
-
-        case 7:
-            std::cout << "  From: ", std::cin >> srcID;
-            std::cout << "    To: ", std::cin >> dstID;
-            graph.initialize(srcID, dstID);
-            graph.findPath();
-            std::cout << "  File Name: ", std::cin >> fileName;
-            savePath(graph, fileName);
-            break;
-
-        case 8:
-            std::cout << "  New Weight: ", std::cin >> weight;
-
-            try
-            {
-                graph.updateWeight(weight);
-            }
-            catch (int e)
-            {
-                if (e == NEGATIVE_WEIGHT)
-                    std::cout << "ERROR - NEGATIVE WEIGHT" << std::endl;
-                else if (e == INCREASED_WEIGHT)
-                    std::cout << " *Increased weight cleared routes"
-                              << std::endl;
-            }
-
-            break;
-
-        case 9:
-            backup(graph);
-            break;
-
-        default:
-            break;
-        }
-    } while (option);
-
-    return 0;
+#include "graph.h"
+#include "file.h"
+#include "writer.h"
+#include "metrics.h"
+#include <iostream>
+
+
+int main()
+{
+    std::cout << "Welcome to A-star Program!" << std::endl;
+    std::cout << "  Option 0: Exit" << std::endl;
+    std::cout << "  Option 1: Insert Points" << std::endl;
+    std::cout << "  Option 2: Erase Points" << std::endl;
+    std::cout << "  Option 3: Clear Points" << std::endl;
+    std::cout << "  Option 4: Insert Routes" << std::endl;
+    std::cout << "  Option 5: Erase Routes" << std::endl;
+    std::cout << "  Option 6: Clear Routes" << std::endl;
+    std::cout << "  Option 7: Find Shortest Path" << std::endl;
+    std::cout << "  Option 8: Update Weight" << std::endl;
+    std::cout << "  Option 9: Backup" << std::endl;
+    std::cout << "  Option 10: Find Bounded Path" << std::endl;
+    std::cout << "  Option 11: Update Limits" << std::endl;
+    std::cout << "  Option 12: Find Batch Paths" << std::endl;
+    std::cout << "  Option 13: Find All Costs" << std::endl;
+    std::cout << "  Option 14: Start Metrics" << std::endl;
+    std::cout << "  Option 15: Stop Metrics" << std::endl;
+
+    unsigned option = 0;
+    Graph graph(0);
+    std::string fileName, queryName;
+    bool binary;
+    std::size_t srcID, dstID;
+    double weight, epsilon, seconds;
+    std::size_t expansions, megabytes;
+    Limits limits;
+    Reporter *reporter = NULL;
+
+    do
+    {
+        std::cout << std::endl
+                  << "Option> ";
+        std::cin >> option;
+
+        switch (option)
+        {
+        case 1:
+            std::cout << "  File Name: ", std::cin >> fileName;
+
+            try
+            {
+                insertPoints(fileName, graph);
+            }
+            catch (int e)
+            {
+                if (e == FILE_NOT_FOUND)
+                    std::cout << "ERROR - FILE NOT FOUND" << std::endl;
+            }
+
+            break;
+
+        case 2:
+            std::cout << "  File Name: ", std::cin >> fileName;
+
+            try
+            {
+                erasePoints(fileName, graph);
+            }
+            catch (int e)
+            {
+                if (e == FILE_NOT_FOUND)
+                    std::cout << "ERROR - FILE NOT FOUND" << std::endl;
+            }
+
+            break;
+
+        case 3:
+            graph.clearPoints();
+            break;
+
+        case 4:
+            std::cout << "  File Name: ", std::cin >> fileName;
+
+            try
+            {
+                insertRoutes(fileName, graph);
+            }
+            catch (int e)
+            {
+                if (e == FILE_NOT_FOUND)
+                    std::cout << "ERROR - FILE NOT FOUND" << std::endl;
+            }
+
+            break;
+
+        case 5:
+            std::cout << "  File Name: ", std::cin >> fileName;
+
+            try
+            {
+                eraseRoutes(fileName, graph);
+            }
+            catch (int e)
+            {
+                if (e == FILE_NOT_FOUND)
+                    std::cout << "ERROR - FILE NOT FOUND" << std::endl;
+            }
+
+            break;
+
+        case 6:
+            graph.clearRoutes();
+            break;
+
+        case 7:
+            std::cout << "  From: ", std::cin >> srcID;
+            std::cout << "    To: ", std::cin >> dstID;
+            graph.initialize(srcID, dstID);
+            graph.findPath();
+
+            if (graph.getStatus() == PATH_CUT_OFF)
+                std::cout << " *Search was cut off" << std::endl;
+
+            std::cout << "  File Name: ", std::cin >> fileName;
+
+            try
+            {
+                savePath(graph, fileName);
+            }
+            catch (int e)
+            {
+                if (e == FILE_NOT_OPENED)
+                    std::cout << "ERROR - FILE NOT OPENED" << std::endl;
+                else if (e == FILE_NOT_WRITTEN)
+                    std::cout << "ERROR - FILE NOT WRITTEN" << std::endl;
+            }
+
+            break;
+
+        case 8:
+            std::cout << "  New Weight: ", std::cin >> weight;
+
+            try
+            {
+                graph.updateWeight(weight);
+            }
+            catch (int e)
+            {
+                if (e == NEGATIVE_WEIGHT)
+                    std::cout << "ERROR - NEGATIVE WEIGHT" << std::endl;
+                else if (e == INCREASED_WEIGHT)
+                    std::cout << " *Increased weight cleared routes"
+                              << std::endl;
+            }
+
+            break;
+
+        case 9:
+            try
+            {
+                backup(graph);
+            }
+            catch (int e)
+            {
+                if (e == FILE_NOT_OPENED)
+                    std::cout << "ERROR - FILE NOT OPENED" << std::endl;
+                else if (e == FILE_NOT_WRITTEN)
+                    std::cout << "ERROR - FILE NOT WRITTEN" << std::endl;
+            }
+
+            break;
+
+        case 10:
+            std::cout << "  From: ", std::cin >> srcID;
+            std::cout << "    To: ", std::cin >> dstID;
+            std::cout << "  Epsilon: ", std::cin >> epsilon;
+            std::cout << "  Seconds: ", std::cin >> seconds;
+            graph.initialize(srcID, dstID);
+
+            try
+            {
+                graph.findPath(epsilon, seconds);
+                std::cout << "  Bound: " << graph.getBound() << std::endl;
+
+                if (graph.getStatus() == PATH_CUT_OFF)
+                    std::cout << " *Search was cut off" << std::endl;
+            }
+            catch (int e)
+            {
+                if (e == NEGATIVE_EPSILON)
+                    std::cout << "ERROR - NEGATIVE EPSILON" << std::endl;
+            }
+
+            std::cout << "  File Name: ", std::cin >> fileName;
+
+            try
+            {
+                savePath(graph, fileName);
+            }
+            catch (int e)
+            {
+                if (e == FILE_NOT_OPENED)
+                    std::cout << "ERROR - FILE NOT OPENED" << std::endl;
+                else if (e == FILE_NOT_WRITTEN)
+                    std::cout << "ERROR - FILE NOT WRITTEN" << std::endl;
+            }
+
+            break;
+
+        case 11:
+            std::cout << "  Seconds (0 = none): ", std::cin >> seconds;
+            std::cout << "  Expansions (0 = none): ", std::cin >> expansions;
+            std::cout << "  Megabytes (0 = none): ", std::cin >> megabytes;
+            limits = Limits();
+
+            if (seconds > 0)
+                limits.seconds = seconds;
+
+            if (expansions > 0)
+                limits.expansions = expansions;
+
+            if (megabytes > 0)
+                limits.bytes = megabytes << 20;
+
+            graph.updateLimits(limits);
+            break;
+
+        case 12:
+            std::cout << "  Query File Name: ", std::cin >> queryName;
+            std::cout << "  File Name: ", std::cin >> fileName;
+            std::cout << "  Binary (0/1): ", std::cin >> binary;
+
+            try
+            {
+                savePaths(queryName, fileName, binary, graph);
+            }
+            catch (int e)
+            {
+                if (e == FILE_NOT_FOUND)
+                    std::cout << "ERROR - FILE NOT FOUND" << std::endl;
+                else if (e == FILE_NOT_OPENED)
+                    std::cout << "ERROR - FILE NOT OPENED" << std::endl;
+                else if (e == FILE_NOT_WRITTEN)
+                    std::cout << "ERROR - FILE NOT WRITTEN" << std::endl;
+            }
+
+            break;
+
+        case 13:
+            std::cout << "  From: ", std::cin >> srcID;
+            std::cout << "  File Name: ", std::cin >> fileName;
+
+            try
+            {
+                saveCosts(graph, srcID, fileName);
+            }
+            catch (int e)
+            {
+                if (e == FILE_NOT_OPENED)
+                    std::cout << "ERROR - FILE NOT OPENED" << std::endl;
+                else if (e == FILE_NOT_WRITTEN)
+                    std::cout << "ERROR - FILE NOT WRITTEN" << std::endl;
+            }
+
+            break;
+
+        case 14:
+            std::cout << "  File Name: ", std::cin >> fileName;
+            std::cout << "  Seconds (0 = on stop): ", std::cin >> seconds;
+            delete reporter, reporter = NULL;
+            Metrics::enable(true);
+
+            try
+            {
+                reporter = new Reporter(fileName, seconds);
+            }
+            catch (int e)
+            {
+                if (e == FILE_NOT_OPENED)
+                    std::cout << "ERROR - FILE NOT OPENED" << std::endl;
+            }
+
+            break;
+
+        case 15:
+            delete reporter, reporter = NULL;
+            Metrics::enable(false);
+            break;
+
+        default:
+            break;
+        }
+    } while (option);
+
+    delete reporter;
+
+    return 0;
 }
\ No newline at end of file
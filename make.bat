@@ -1,8 +1,44 @@
-@echo off
-rem gcc 9.2.0 (tdm64) win10
-g++ graph.cpp -O3 -std=c++98 -Wall -c
-pause
-g++ file.cpp -O3 -std=c++98 -Wall -c
-pause
-g++ graph.o file.o main.cpp -O3 -std=c++98 -Wall -o a-star.exe
+@echo off
+rem gcc 9.2.0 (tdm64) win10
+g++ graph.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ component.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ destination.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ snapshot.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ parallel.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ stepping.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ landmark.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ search.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ traffic.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ alternative.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ overlay.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ compressed.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ mapped.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ distributed.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ metrics.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ writer.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ file.cpp -O3 -std=c++98 -Wall -c
+pause
+g++ graph.o component.o destination.o metrics.o snapshot.o parallel.o stepping.o landmark.o search.o traffic.o alternative.o overlay.o compressed.o mapped.o distributed.o writer.o file.o main.cpp -O3 -std=c++98 -Wall -o a-star.exe
+pause
+g++ graph.o component.o destination.o metrics.o snapshot.o parallel.o stepping.o landmark.o search.o distributed.o bench.cpp -O3 -std=c++98 -Wall -o bench.exe
+pause
+g++ graph.o component.o destination.o metrics.o snapshot.o parallel.o stepping.o landmark.o search.o traffic.o alternative.o overlay.o compressed.o mapped.o distributed.o writer.o test.cpp -O3 -std=c++98 -Wall -o test.exe
+pause
+test.exe
 pause
\ No newline at end of file
@@ -0,0 +1,527 @@
+#include "mapped.h"
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <cmath>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#define MAPPED_POSIX
+#endif
+
+
+struct Header
+{
+    char magic[8];
+    std::size_t width;
+    std::size_t size;
+    std::size_t bytes;
+    double weight;
+    double scale;
+    double margin;
+    unsigned narrow;
+    unsigned octahedral;
+};
+
+static const char MAGIC[8] = {'A', 'S', 'T', 'A', 'R', 'C', 'G', '2'};
+static const std::size_t BLOCK = 4096;
+
+static std::size_t align(std::size_t offset)
+{
+    return (offset + BLOCK - 1) / BLOCK * BLOCK;
+}
+
+static void locate(const Header &header, std::size_t sections[6])
+{
+    std::size_t units = header.octahedral
+                            ? 2 * header.size * sizeof(short)
+                            : 3 * header.size * sizeof(float);
+    sections[0] = align(sizeof(Header));
+    sections[1] = align(sections[0] + header.size * sizeof(std::size_t));
+    sections[2] = align(sections[1] + header.size * sizeof(unsigned));
+    sections[3] = align(sections[2] +
+                        (header.size + 1) * sizeof(std::size_t));
+    sections[4] = align(sections[3] + units);
+    sections[5] = sections[4] + header.bytes;
+}
+
+static void writeSection(std::FILE *file, std::size_t offset,
+                         const void *data, std::size_t length)
+{
+    static const char zeros[BLOCK] = {0};
+    long position = std::ftell(file);
+
+    if (position >= 0 && (std::size_t)position < offset)
+        std::fwrite(zeros, 1, offset - position, file);
+
+    if (length)
+        std::fwrite(data, 1, length, file);
+}
+
+static bool checkArcs(const unsigned char *pos, const unsigned char *last,
+                      std::size_t index, std::size_t size, bool narrow)
+{
+    std::size_t v = index;
+    bool first = true;
+
+    while (pos < last)
+    {
+        std::size_t delta = 0;
+
+        for (unsigned shift = 0;; shift += 7)
+        {
+            if (pos == last || shift >= sizeof(std::size_t) * 8)
+                return false;
+
+            unsigned char byte = *pos++;
+            delta |= (std::size_t)(byte & 0x7F) << shift;
+
+            if (!(byte & 0x80))
+                break;
+        }
+
+        if (first)
+            v += delta & 1 ? ~(delta >> 1) : delta >> 1, first = false;
+        else
+            v += delta;
+
+        if (v >= size || (std::size_t)(last - pos) < (narrow ? 2u : 4u))
+            return false;
+
+        pos += narrow ? 2 : 4;
+    }
+
+    return true;
+}
+
+static std::size_t measureFaults()
+{
+#ifdef MAPPED_POSIX
+    struct rusage usage;
+
+    if (!getrusage(RUSAGE_SELF, &usage))
+        return usage.ru_minflt + usage.ru_majflt;
+#endif
+
+    return 0;
+}
+
+
+void Mapped::save(const Compressed &graph, const char *fileName)
+{
+    Header header;
+    std::memset(&header, 0, sizeof(Header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.width = sizeof(std::size_t);
+    header.size = graph.size();
+    header.bytes = graph.bytes.size();
+    header.weight = graph.weight;
+    header.scale = graph.scale;
+    header.margin = graph.margin;
+    header.narrow = graph.narrow;
+    header.octahedral = graph.octahedral;
+
+    std::size_t sections[6];
+    locate(header, sections);
+    std::FILE *file = std::fopen(fileName, "wb");
+
+    if (!file)
+        throw FILE_NOT_OPENED;
+
+    std::fwrite(&header, sizeof(Header), 1, file);
+    writeSection(file, sections[0], graph.IDs.empty() ? 0 : &graph.IDs[0],
+                 graph.IDs.size() * sizeof(std::size_t));
+    writeSection(file, sections[1],
+                 graph.order.empty() ? 0 : &graph.order[0],
+                 graph.order.size() * sizeof(unsigned));
+    writeSection(file, sections[2], &graph.offsets[0],
+                 graph.offsets.size() * sizeof(std::size_t));
+
+    if (graph.octahedral)
+        writeSection(file, sections[3],
+                     graph.shorts.empty() ? 0 : &graph.shorts[0],
+                     graph.shorts.size() * sizeof(short));
+    else
+        writeSection(file, sections[3],
+                     graph.floats.empty() ? 0 : &graph.floats[0],
+                     graph.floats.size() * sizeof(float));
+
+    writeSection(file, sections[4], &graph.bytes[0], graph.bytes.size());
+    std::fclose(file);
+}
+
+Mapped::Mapped(const char *fileName)
+{
+    this->base = 0;
+    this->length = 0;
+
+#ifdef MAPPED_POSIX
+    int descriptor = open(fileName, O_RDONLY);
+
+    if (descriptor < 0)
+        throw FILE_NOT_FOUND;
+
+    struct stat status;
+
+    if (!fstat(descriptor, &status) && status.st_size > 0)
+    {
+        void *address = mmap(0, status.st_size, PROT_READ, MAP_PRIVATE,
+                             descriptor, 0);
+
+        if (address != MAP_FAILED)
+        {
+            this->base = (const unsigned char *)address;
+            this->length = status.st_size;
+            madvise(address, this->length, MADV_RANDOM);
+        }
+    }
+
+    close(descriptor);
+#endif
+
+    if (!this->base)
+    {
+        std::FILE *file = std::fopen(fileName, "rb");
+
+        if (!file)
+            throw FILE_NOT_FOUND;
+
+        unsigned char chunk[BLOCK];
+        std::size_t read;
+
+        while ((read = std::fread(chunk, 1, BLOCK, file)) > 0)
+            this->buffer.insert(this->buffer.end(), chunk, chunk + read);
+
+        std::fclose(file);
+        this->length = this->buffer.size();
+        this->base = this->buffer.empty() ? 0 : &this->buffer[0];
+    }
+
+    Header header;
+    std::size_t sections[6] = {0};
+
+    if (this->length >= sizeof(Header))
+    {
+        std::memcpy(&header, this->base, sizeof(Header));
+
+        if (header.size < this->length && header.bytes < this->length)
+            locate(header, sections);
+    }
+
+    if (this->length < sizeof(Header) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) ||
+        header.width != sizeof(std::size_t) ||
+        header.size >= this->length || header.bytes >= this->length ||
+        header.narrow > 1 || header.octahedral > 1 ||
+        sections[5] > this->length)
+    {
+        this->release();
+        throw INVALID_FILE;
+    }
+
+    this->count = header.size;
+    this->weight = header.weight;
+    this->scale = header.scale;
+    this->margin = header.margin;
+    this->narrow = header.narrow;
+    this->octahedral = header.octahedral;
+    this->IDs = (const std::size_t *)(this->base + sections[0]);
+    this->order = (const unsigned *)(this->base + sections[1]);
+    this->offsets = (const std::size_t *)(this->base + sections[2]);
+    this->floats = (const float *)(this->base + sections[3]);
+    this->shorts = (const short *)(this->base + sections[3]);
+    this->bytes = this->base + sections[4];
+
+    if (!this->check(header.bytes))
+    {
+        this->release();
+        throw INVALID_FILE;
+    }
+}
+
+bool Mapped::check(std::size_t bytes) const
+{
+    if (this->offsets[0] != 0 || this->offsets[this->count] > bytes)
+        return false;
+
+    for (std::size_t i = 0; i < this->count; ++i)
+        if (this->order[i] >= this->count ||
+            (i && this->IDs[this->order[i - 1]] >= this->IDs[this->order[i]]) ||
+            this->offsets[i] > this->offsets[i + 1])
+            return false;
+
+#ifdef MAPPED_POSIX
+    if (this->buffer.empty())
+        madvise((void *)this->base, this->length, MADV_SEQUENTIAL);
+#endif
+
+    for (std::size_t i = 0; i < this->count; ++i)
+        if (!checkArcs(this->bytes + this->offsets[i],
+                       this->bytes + this->offsets[i + 1],
+                       i, this->count, this->narrow))
+            return false;
+
+#ifdef MAPPED_POSIX
+    if (this->buffer.empty())
+        madvise((void *)this->base, this->length, MADV_RANDOM);
+#endif
+
+    return true;
+}
+
+void Mapped::release()
+{
+#ifdef MAPPED_POSIX
+    if (this->buffer.empty() && this->base)
+        munmap((void *)this->base, this->length);
+#endif
+
+    this->base = 0;
+}
+
+Mapped::~Mapped()
+{
+    this->release();
+}
+
+std::size_t Mapped::size() const
+{
+    return this->count;
+}
+
+std::size_t Mapped::countBytes() const
+{
+    return this->length;
+}
+
+std::size_t Mapped::countBlocks() const
+{
+    return this->offsets[this->count] / BLOCK + 1;
+}
+
+std::size_t Mapped::getBlock(std::size_t index) const
+{
+    return this->offsets[index] / BLOCK;
+}
+
+void Mapped::prefetch(std::size_t index) const
+{
+#ifdef MAPPED_POSIX
+    std::size_t page = sysconf(_SC_PAGESIZE),
+                lower = (this->bytes - this->base) + this->offsets[index],
+                upper = (this->bytes - this->base) + this->offsets[index + 1];
+    lower = lower / page * page;
+    madvise((void *)(this->base + lower), upper - lower + 1, MADV_WILLNEED);
+#else
+    (void)index;
+#endif
+}
+
+std::size_t Mapped::find(std::size_t ID) const
+{
+    std::size_t lower = 0, upper = this->count;
+
+    while (lower < upper)
+    {
+        std::size_t middle = (lower + upper) / 2;
+
+        if (this->IDs[this->order[middle]] < ID)
+            lower = middle + 1;
+        else
+            upper = middle;
+    }
+
+    if (lower == this->count || this->IDs[this->order[lower]] != ID)
+        return this->count;
+
+    return this->order[lower];
+}
+
+std::size_t Mapped::getID(std::size_t index) const
+{
+    return this->IDs[index];
+}
+
+double Mapped::getWeight() const
+{
+    return this->weight;
+}
+
+double Mapped::getMargin() const
+{
+    return this->margin;
+}
+
+void Mapped::getUnit(std::size_t index, double &unitX,
+                     double &unitY, double &unitZ) const
+{
+    if (this->octahedral)
+    {
+        decodeUnit(this->shorts[2 * index], this->shorts[2 * index + 1],
+                   unitX, unitY, unitZ);
+        return;
+    }
+
+    unitX = this->floats[3 * index];
+    unitY = this->floats[3 * index + 1];
+    unitZ = this->floats[3 * index + 2];
+}
+
+
+void BlockHeap::push(double key, std::size_t v)
+{
+    if (this->width < 0)
+        this->width = this->paged.buckets ? key / this->paged.buckets : 0;
+
+    Item item;
+    item.first = key;
+    item.bucket = this->width > 0 ? std::floor(key / this->width) : key;
+    item.tier = v == this->paged.dst ? 2 : this->paged.touch(v) ? 0 : 1;
+    item.second = v;
+    this->items.push_back(item);
+    std::push_heap(this->items.begin(), this->items.end(),
+                   std::greater<Item>());
+}
+
+
+void Paged::fetch(std::size_t index) const
+{
+    std::size_t block = this->graph.getBlock(index);
+    this->current = block;
+
+    if (this->fetches[block] != this->stamp)
+    {
+        this->fetches[block] = this->stamp;
+        ++this->fetched;
+    }
+}
+
+Paged::Paged(const Mapped &graph, std::size_t buckets)
+    : graph(graph), queue(*this)
+{
+    this->src = this->dst = -1;
+    this->current = -1;
+    this->buckets = buckets;
+    this->expanded = this->fetched = this->prefetched = this->faults = 0;
+    this->stamp = 0;
+    this->fetches.assign(graph.countBlocks(), 0);
+    this->prefetches.assign(graph.countBlocks(), 0);
+}
+
+bool Paged::touch(std::size_t index)
+{
+    std::size_t block = this->graph.getBlock(index);
+
+    if (this->fetches[block] != this->stamp &&
+        this->prefetches[block] != this->stamp)
+    {
+        this->prefetches[block] = this->stamp;
+        ++this->prefetched;
+        this->graph.prefetch(index);
+    }
+
+    return block == this->current;
+}
+
+void Paged::findPath(std::size_t srcID, std::size_t dstID)
+{
+    if (++this->stamp == 0)
+    {
+        this->fetches.assign(this->fetches.size(), 0);
+        this->prefetches.assign(this->prefetches.size(), 0);
+        this->stamp = 1;
+    }
+
+    this->src = this->graph.find(srcID);
+    this->dst = this->graph.find(dstID);
+    this->expanded = this->fetched = this->prefetched = this->faults = 0;
+    this->current = -1;
+
+    if (this->src >= this->graph.size() || this->dst >= this->graph.size())
+    {
+        this->src = this->dst = -1;
+        return;
+    }
+
+    std::size_t faults = measureFaults();
+    Approximate<Paged> heuristic;
+    this->expanded =
+        solve<Paged, Approximate<Paged>, BlockHeap,
+              double, StopAtTarget>(*this, heuristic, this->queue,
+                                    this->space, this->src, this->dst);
+    this->faults = measureFaults() - faults;
+}
+
+std::size_t Paged::countExpanded() const
+{
+    return this->expanded;
+}
+
+std::size_t Paged::countFetched() const
+{
+    return this->fetched;
+}
+
+std::size_t Paged::countPrefetched() const
+{
+    return this->prefetched;
+}
+
+std::size_t Paged::countFaults() const
+{
+    return this->faults;
+}
+
+std::size_t Paged::countBytes() const
+{
+    return this->space.countBytes();
+}
+
+std::vector<std::size_t> Paged::getPath() const
+{
+    std::vector<std::size_t> path;
+
+    if (this->getCosts() == std::numeric_limits<double>::infinity())
+        return path;
+
+    for (std::size_t v = this->dst; v != (std::size_t)-1;
+         v = this->space.prevs[this->space.find(v)])
+        path.push_back(this->graph.getID(v));
+
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
+
+double Paged::getCosts() const
+{
+    if (this->dst == (std::size_t)-1)
+        return std::numeric_limits<double>::infinity();
+
+    return this->space.getCosts(this->dst);
+}
+
+std::size_t Paged::size() const
+{
+    return this->graph.size();
+}
+
+double Paged::getWeight() const
+{
+    return this->graph.getWeight();
+}
+
+double Paged::getMargin() const
+{
+    return this->graph.getMargin();
+}
+
+void Paged::getUnit(std::size_t index, double &unitX,
+                    double &unitY, double &unitZ) const
+{
+    this->graph.getUnit(index, unitX, unitY, unitZ);
+}
\ No newline at end of file
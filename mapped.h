@@ -0,0 +1,197 @@
+#ifndef MAPPED_H
+#define MAPPED_H
+
+#include "compressed.h"
+
+
+#ifndef FILE_NOT_FOUND
+#define FILE_NOT_FOUND 1
+#endif
+
+#ifndef FILE_NOT_OPENED
+#define FILE_NOT_OPENED 2
+#endif
+
+#ifndef INVALID_FILE
+#define INVALID_FILE 61
+#endif
+
+
+class Mapped
+{
+    const unsigned char *base;
+    std::size_t length;
+    std::vector<unsigned char> buffer;
+    std::size_t count;
+    double weight;
+    double scale;
+    double margin;
+    bool narrow;
+    bool octahedral;
+    const std::size_t *IDs;
+    const unsigned *order;
+    const std::size_t *offsets;
+    const float *floats;
+    const short *shorts;
+    const unsigned char *bytes;
+
+    bool check(std::size_t) const;
+    void release();
+
+    Mapped(const Mapped &);
+    Mapped &operator=(const Mapped &);
+
+public:
+    class Arcs
+    {
+        Packed arcs;
+
+    public:
+        Arcs(const Mapped &graph, std::size_t index)
+            : arcs(graph.bytes + graph.offsets[index],
+                   graph.bytes + graph.offsets[index + 1],
+                   index, graph.scale, graph.narrow)
+        {
+        }
+
+        bool valid() const { return this->arcs.valid(); }
+        void next() { this->arcs.next(); }
+        std::size_t target() const { return this->arcs.target(); }
+        double cost() const { return this->arcs.cost(); }
+    };
+
+    static void save(const Compressed &, const char *);
+
+    Mapped(const char *);
+    ~Mapped();
+
+    std::size_t size() const;
+    std::size_t countBytes() const;
+    std::size_t countBlocks() const;
+    std::size_t getBlock(std::size_t) const;
+    void prefetch(std::size_t) const;
+    std::size_t find(std::size_t) const;
+    std::size_t getID(std::size_t) const;
+    double getWeight() const;
+    double getMargin() const;
+    void getUnit(std::size_t, double &, double &, double &) const;
+};
+
+
+class Paged;
+
+
+class BlockHeap
+{
+    struct Item
+    {
+        double first;
+        double bucket;
+        int tier;
+        std::size_t second;
+
+        bool operator>(const Item &other) const
+        {
+            if (this->bucket != other.bucket)
+                return this->bucket > other.bucket;
+
+            if (this->tier != other.tier)
+                return this->tier > other.tier;
+
+            if (this->first != other.first)
+                return this->first > other.first;
+
+            return this->second > other.second;
+        }
+    };
+
+    Paged &paged;
+    double width;
+    std::vector<Item> items;
+
+public:
+    BlockHeap(Paged &paged) : paged(paged), width(-1) {}
+
+    bool empty() const { return this->items.empty(); }
+
+    void clear()
+    {
+        this->items.clear();
+        this->width = -1;
+    }
+
+    const Item &top() const { return this->items.front(); }
+
+    void push(double, std::size_t);
+
+    void pop()
+    {
+        std::pop_heap(this->items.begin(), this->items.end(),
+                      std::greater<Item>());
+        this->items.pop_back();
+    }
+};
+
+
+class Paged
+{
+    friend class BlockHeap;
+
+    const Mapped &graph;
+    std::size_t src;
+    std::size_t dst;
+    std::size_t expanded;
+    mutable std::size_t fetched;
+    std::size_t prefetched;
+    std::size_t faults;
+    std::size_t buckets;
+    mutable std::size_t current;
+    unsigned stamp;
+    mutable std::vector<unsigned> fetches;
+    std::vector<unsigned> prefetches;
+    Visited<double> space;
+    BlockHeap queue;
+
+    void fetch(std::size_t) const;
+
+    Paged(const Paged &);
+    Paged &operator=(const Paged &);
+
+public:
+    class Arcs
+    {
+        Mapped::Arcs arcs;
+
+    public:
+        Arcs(const Paged &graph, std::size_t index)
+            : arcs(graph.graph, index)
+        {
+            graph.fetch(index);
+        }
+
+        bool valid() const { return this->arcs.valid(); }
+        void next() { this->arcs.next(); }
+        std::size_t target() const { return this->arcs.target(); }
+        double cost() const { return this->arcs.cost(); }
+    };
+
+    Paged(const Mapped &, std::size_t = 32);
+
+    bool touch(std::size_t);
+    void findPath(std::size_t, std::size_t);
+    std::size_t countExpanded() const;
+    std::size_t countFetched() const;
+    std::size_t countPrefetched() const;
+    std::size_t countFaults() const;
+    std::size_t countBytes() const;
+    std::vector<std::size_t> getPath() const;
+    double getCosts() const;
+
+    std::size_t size() const;
+    double getWeight() const;
+    double getMargin() const;
+    void getUnit(std::size_t, double &, double &, double &) const;
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,473 @@
+#include "metrics.h"
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#if __cplusplus >= 201103L
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+
+#if __cplusplus >= 201103L
+typedef std::atomic<std::size_t> Cell;
+typedef std::atomic<bool> Flag;
+
+static std::size_t load(const Cell &cell)
+{
+    return cell.load(std::memory_order_relaxed);
+}
+
+static void store(Cell &cell, std::size_t value)
+{
+    cell.store(value, std::memory_order_relaxed);
+}
+
+static bool test(const Flag &flag)
+{
+    return flag.load(std::memory_order_relaxed);
+}
+
+static void set(Flag &flag, bool value)
+{
+    flag.store(value, std::memory_order_relaxed);
+}
+#else
+typedef std::size_t Cell;
+typedef bool Flag;
+
+static std::size_t load(const Cell &cell)
+{
+    return cell;
+}
+
+static void store(Cell &cell, std::size_t value)
+{
+    cell = value;
+}
+
+static bool test(const Flag &flag)
+{
+    return flag;
+}
+
+static void set(Flag &flag, bool value)
+{
+    flag = value;
+}
+#endif
+
+
+struct Slot
+{
+    Flag owned;
+    Cell samples[Metrics::TIMERS];
+    Cell totals[Metrics::TIMERS];
+    Cell maxima[Metrics::TIMERS];
+    Cell buckets[Metrics::TIMERS][Metrics::BUCKETS];
+    Cell counters[Metrics::COUNTERS];
+    Slot *next;
+
+    Slot();
+
+    void clear();
+};
+
+Slot::Slot()
+{
+    set(this->owned, false);
+    this->next = NULL;
+    this->clear();
+}
+
+void Slot::clear()
+{
+    for (std::size_t t = 0; t < Metrics::TIMERS; ++t)
+    {
+        store(this->samples[t], 0);
+        store(this->totals[t], 0);
+        store(this->maxima[t], 0);
+
+        for (std::size_t b = 0; b < Metrics::BUCKETS; ++b)
+            store(this->buckets[t][b], 0);
+    }
+
+    for (std::size_t c = 0; c < Metrics::COUNTERS; ++c)
+        store(this->counters[c], 0);
+}
+
+
+static const char *TIMER_NAMES[Metrics::TIMERS] = {
+    "initialize", "find_path", "write"};
+static const char *COUNTER_NAMES[Metrics::COUNTERS] = {
+    "routes_loaded", "routes_rejected", "cache_hits", "cache_misses",
+    "graph_version"};
+
+static Flag active;
+static Cell gauges[Metrics::COUNTERS];
+
+#if __cplusplus >= 201103L
+static std::atomic<Slot *> slots(NULL);
+
+struct Owner
+{
+    Slot *slot;
+
+    Owner() : slot(NULL) {}
+
+    ~Owner()
+    {
+        if (this->slot)
+            this->slot->owned.store(false, std::memory_order_release);
+    }
+};
+
+static thread_local Owner owner;
+
+static Slot *acquire()
+{
+    if (owner.slot)
+        return owner.slot;
+
+    for (Slot *slot = slots.load(std::memory_order_acquire); slot;
+         slot = slot->next)
+    {
+        bool expected = false;
+
+        if (!test(slot->owned) &&
+            slot->owned.compare_exchange_strong(expected, true,
+                                                std::memory_order_acquire))
+            return owner.slot = slot;
+    }
+
+    Slot *slot = new Slot;
+    set(slot->owned, true);
+    slot->next = slots.load(std::memory_order_relaxed);
+
+    while (!slots.compare_exchange_weak(slot->next, slot,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed))
+        ;
+
+    return owner.slot = slot;
+}
+
+static Slot *first()
+{
+    return slots.load(std::memory_order_acquire);
+}
+#else
+static Slot single;
+
+static Slot *acquire()
+{
+    return &single;
+}
+
+static Slot *first()
+{
+    return &single;
+}
+#endif
+
+static double now()
+{
+#if __cplusplus >= 201103L
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#elif defined(__unix__) || defined(__APPLE__)
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+#else
+    return (double)std::clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static std::size_t locate(std::size_t value)
+{
+    std::size_t shift = 0;
+
+    while (value >> shift >= 64)
+        ++shift;
+
+    if (!shift)
+        return value;
+
+    return std::min(Metrics::BUCKETS - 1,
+                    (shift + 1) * 32 + (value >> shift) - 32);
+}
+
+static std::size_t limit(std::size_t index)
+{
+    if (index < 64)
+        return index;
+
+    std::size_t shift = index / 32 - 1;
+
+    return ((32 + index % 32 + 1) << shift) - 1;
+}
+
+
+void Metrics::enable(bool enabled)
+{
+    set(active, enabled);
+}
+
+bool Metrics::enabled()
+{
+    return test(active);
+}
+
+void Metrics::record(int timer, double seconds)
+{
+    if (!test(active))
+        return;
+
+    Slot &slot = *acquire();
+    std::size_t nanos = seconds > 0 ? (std::size_t)(seconds * 1e9) : 0;
+    Cell &bucket = slot.buckets[timer][locate(nanos)];
+    store(bucket, load(bucket) + 1);
+    store(slot.samples[timer], load(slot.samples[timer]) + 1);
+    store(slot.totals[timer], load(slot.totals[timer]) + nanos);
+
+    if (nanos > load(slot.maxima[timer]))
+        store(slot.maxima[timer], nanos);
+}
+
+void Metrics::count(int counter, std::size_t value)
+{
+    if (!test(active))
+        return;
+
+    Slot &slot = *acquire();
+    store(slot.counters[counter], load(slot.counters[counter]) + value);
+}
+
+void Metrics::update(int counter, std::size_t value)
+{
+    if (test(active))
+        store(gauges[counter], value);
+}
+
+void Metrics::reset()
+{
+    for (Slot *slot = first(); slot; slot = slot->next)
+        slot->clear();
+
+    for (std::size_t c = 0; c < COUNTERS; ++c)
+        store(gauges[c], 0);
+}
+
+std::size_t Metrics::countSamples(int timer)
+{
+    std::size_t samples = 0;
+
+    for (Slot *slot = first(); slot; slot = slot->next)
+        samples += load(slot->samples[timer]);
+
+    return samples;
+}
+
+double Metrics::getQuantile(int timer, double quantile)
+{
+    std::vector<std::size_t> buckets(BUCKETS, 0);
+    std::size_t samples = 0, maximum = 0, seen = 0;
+
+    for (Slot *slot = first(); slot; slot = slot->next)
+    {
+        for (std::size_t b = 0; b < BUCKETS; ++b)
+            buckets[b] += load(slot->buckets[timer][b]);
+
+        maximum = std::max(maximum, load(slot->maxima[timer]));
+    }
+
+    for (std::size_t b = 0; b < BUCKETS; ++b)
+        samples += buckets[b];
+
+    for (std::size_t b = 0; b < BUCKETS; ++b)
+    {
+        seen += buckets[b];
+
+        if (buckets[b] && seen >= quantile * samples)
+            return std::min(limit(b), maximum) * 1e-9;
+    }
+
+    return 0;
+}
+
+std::size_t Metrics::getCounter(int counter)
+{
+    std::size_t value = load(gauges[counter]);
+
+    for (Slot *slot = first(); slot; slot = slot->next)
+        value += load(slot->counters[counter]);
+
+    return value;
+}
+
+void Metrics::dump(std::ostream &out)
+{
+    static const double quantiles[] = {0.5, 0.9, 0.99, 0.999};
+    static const char *labels[] = {"p50", "p90", "p99", "p999"};
+
+    for (std::size_t t = 0; t < TIMERS; ++t)
+    {
+        std::size_t samples = 0, totals = 0, maximum = 0;
+
+        for (Slot *slot = first(); slot; slot = slot->next)
+        {
+            samples += load(slot->samples[t]);
+            totals += load(slot->totals[t]);
+            maximum = std::max(maximum, load(slot->maxima[t]));
+        }
+
+        out << TIMER_NAMES[t] << "_samples " << samples << '\n';
+        out << TIMER_NAMES[t] << "_mean_us "
+            << (samples ? totals * 1e-3 / samples : 0) << '\n';
+
+        for (std::size_t q = 0; q < 4; ++q)
+            out << TIMER_NAMES[t] << '_' << labels[q] << "_us "
+                << getQuantile(t, quantiles[q]) * 1e6 << '\n';
+
+        out << TIMER_NAMES[t] << "_max_us " << maximum * 1e-3 << '\n';
+    }
+
+    for (std::size_t c = 0; c < COUNTERS; ++c)
+        out << COUNTER_NAMES[c] << ' ' << getCounter(c) << '\n';
+
+    std::size_t hits = getCounter(COUNTER_HITS),
+                misses = getCounter(COUNTER_MISSES);
+    out << "cache_hit_rate "
+        << (hits + misses ? (double)hits / (hits + misses) : 0) << '\n';
+}
+
+void Metrics::dump(const std::string &fileName)
+{
+    std::string tempName = fileName + ".tmp";
+
+    {
+        std::ofstream fout(tempName.c_str());
+
+        if (fout.fail())
+            throw FILE_NOT_OPENED;
+
+        dump(fout);
+    }
+
+    if (std::rename(tempName.c_str(), fileName.c_str()))
+    {
+        std::remove(fileName.c_str());
+        std::rename(tempName.c_str(), fileName.c_str());
+    }
+}
+
+
+Timer::Timer(int timer)
+{
+    this->timer = timer;
+    this->start = test(active) ? now() : -1;
+}
+
+Timer::~Timer()
+{
+    if (this->start >= 0)
+        Metrics::record(this->timer, now() - this->start);
+}
+
+
+struct Ticker
+{
+#if __cplusplus >= 201103L
+    std::string fileName;
+    double seconds;
+    bool closing;
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::thread thread;
+
+    Ticker(const std::string &, double);
+
+    void run();
+    void stop();
+#endif
+};
+
+
+#if __cplusplus >= 201103L
+Ticker::Ticker(const std::string &fileName, double seconds)
+{
+    this->fileName = fileName;
+    this->seconds = seconds;
+    this->closing = false;
+    this->thread = std::thread(&Ticker::run, this);
+}
+
+void Ticker::run()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while (!this->cond.wait_for(lock,
+                                std::chrono::duration<double>(this->seconds),
+                                [this]
+                                { return this->closing; }))
+    {
+        try
+        {
+            Metrics::dump(this->fileName);
+        }
+        catch (int)
+        {
+        }
+    }
+}
+
+void Ticker::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->closing = true;
+        this->cond.notify_all();
+    }
+
+    this->thread.join();
+}
+#endif
+
+
+Reporter::Reporter(const std::string &fileName, double seconds)
+{
+    this->fileName = fileName;
+    Metrics::dump(fileName);
+
+#if __cplusplus >= 201103L
+    this->ticker = seconds > 0 ? new Ticker(fileName, seconds) : NULL;
+#else
+    (void)seconds;
+    this->ticker = NULL;
+#endif
+}
+
+Reporter::~Reporter()
+{
+#if __cplusplus >= 201103L
+    if (this->ticker)
+    {
+        this->ticker->stop();
+        delete this->ticker;
+    }
+#endif
+
+    try
+    {
+        Metrics::dump(this->fileName);
+    }
+    catch (int)
+    {
+    }
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+
+#ifndef FILE_NOT_OPENED
+#define FILE_NOT_OPENED 2
+#endif
+
+#ifndef TIMER_INITIALIZE
+#define TIMER_INITIALIZE 0
+#endif
+
+#ifndef TIMER_FIND_PATH
+#define TIMER_FIND_PATH 1
+#endif
+
+#ifndef TIMER_WRITE
+#define TIMER_WRITE 2
+#endif
+
+#ifndef COUNTER_LOADED
+#define COUNTER_LOADED 0
+#endif
+
+#ifndef COUNTER_REJECTED
+#define COUNTER_REJECTED 1
+#endif
+
+#ifndef COUNTER_HITS
+#define COUNTER_HITS 2
+#endif
+
+#ifndef COUNTER_MISSES
+#define COUNTER_MISSES 3
+#endif
+
+#ifndef COUNTER_VERSION
+#define COUNTER_VERSION 4
+#endif
+
+
+struct Ticker;
+
+
+class Metrics
+{
+public:
+    static const std::size_t TIMERS = 3;
+    static const std::size_t COUNTERS = 5;
+    static const std::size_t BUCKETS = 36 * 32;
+
+    static void enable(bool);
+    static bool enabled();
+    static void record(int, double);
+    static void count(int, std::size_t = 1);
+    static void update(int, std::size_t);
+    static void reset();
+    static std::size_t countSamples(int);
+    static double getQuantile(int, double);
+    static std::size_t getCounter(int);
+    static void dump(std::ostream &);
+    static void dump(const std::string &);
+};
+
+
+class Timer
+{
+    int timer;
+    double start;
+
+public:
+    Timer(int);
+    ~Timer();
+};
+
+
+class Reporter
+{
+    std::string fileName;
+    Ticker *ticker;
+
+    Reporter(const Reporter &);
+    Reporter &operator=(const Reporter &);
+
+public:
+    Reporter(const std::string &, double);
+    ~Reporter();
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,474 @@
+#include "overlay.h"
+#include "parallel.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+void Partition::split(std::vector<std::size_t> &order,
+                      std::size_t lower, std::size_t upper,
+                      std::size_t depth,
+                      const std::vector<std::size_t> &depths)
+{
+    for (std::size_t k = 0; k < depths.size(); ++k)
+        if (depths[k] == depth)
+        {
+            for (std::size_t i = lower; i < upper; ++i)
+                this->cells[k][order[i]] = this->counts[k];
+
+            ++this->counts[k];
+        }
+
+    if (depth == depths[0])
+        return;
+
+    if (upper - lower < 2)
+    {
+        this->split(order, lower, upper, depth + 1, depths);
+        return;
+    }
+
+    double mean[3] = {0, 0, 0}, inertia[3][3] = {{0}}, axis[3];
+
+    for (std::size_t i = lower; i < upper; ++i)
+    {
+        const Point &point = this->snapshot.getPoint(order[i]);
+        mean[0] += point.unitX, mean[1] += point.unitY, mean[2] += point.unitZ;
+    }
+
+    for (std::size_t a = 0; a < 3; ++a)
+        mean[a] /= upper - lower;
+
+    for (std::size_t i = lower; i < upper; ++i)
+    {
+        const Point &point = this->snapshot.getPoint(order[i]);
+        double offset[3] = {point.unitX - mean[0],
+                            point.unitY - mean[1],
+                            point.unitZ - mean[2]};
+
+        for (std::size_t a = 0; a < 3; ++a)
+            for (std::size_t b = 0; b < 3; ++b)
+                inertia[a][b] += offset[a] * offset[b];
+    }
+
+    std::size_t widest = 0;
+
+    for (std::size_t a = 1; a < 3; ++a)
+        if (inertia[a][a] > inertia[widest][widest])
+            widest = a;
+
+    for (std::size_t a = 0; a < 3; ++a)
+        axis[a] = a == widest;
+
+    for (std::size_t round = 0; round < 16; ++round)
+    {
+        double next[3] = {0, 0, 0}, norm = 0;
+
+        for (std::size_t a = 0; a < 3; ++a)
+        {
+            for (std::size_t b = 0; b < 3; ++b)
+                next[a] += inertia[a][b] * axis[b];
+
+            norm += next[a] * next[a];
+        }
+
+        if (!(norm > 0))
+            break;
+
+        for (std::size_t a = 0; a < 3; ++a)
+            axis[a] = next[a] / std::sqrt(norm);
+    }
+
+    std::vector<std::pair<double, std::size_t> > keys;
+
+    for (std::size_t i = lower; i < upper; ++i)
+    {
+        const Point &point = this->snapshot.getPoint(order[i]);
+        keys.push_back(std::make_pair(point.unitX * axis[0] +
+                                          point.unitY * axis[1] +
+                                          point.unitZ * axis[2],
+                                      order[i]));
+    }
+
+    std::size_t middle = (upper - lower) / 2;
+    std::nth_element(keys.begin(), keys.begin() + middle, keys.end());
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        order[lower + i] = keys[i].second;
+
+    this->split(order, lower, lower + middle, depth + 1, depths);
+    this->split(order, lower + middle, upper, depth + 1, depths);
+}
+
+Partition::Partition(const Snapshot &snapshot, std::size_t cellSize,
+                     std::size_t levels)
+    : snapshot(snapshot)
+{
+    std::size_t size = snapshot.size(), deepest = 0;
+    std::vector<std::size_t> depths, order(size);
+
+    while (cellSize && size > cellSize << deepest)
+        ++deepest;
+
+    for (std::size_t k = 0; k < std::max<std::size_t>(levels, 1); ++k)
+    {
+        if (k && deepest <= 4 * k)
+            break;
+
+        depths.push_back(deepest - 4 * k);
+    }
+
+    this->cells.assign(depths.size(), std::vector<std::size_t>(size, 0));
+    this->counts.assign(depths.size(), 0);
+
+    for (std::size_t v = 0; v < size; ++v)
+        order[v] = v;
+
+    this->split(order, 0, size, 0, depths);
+}
+
+const Snapshot &Partition::getSnapshot() const
+{
+    return this->snapshot;
+}
+
+std::size_t Partition::countLevels() const
+{
+    return this->cells.size();
+}
+
+std::size_t Partition::countCells(std::size_t level) const
+{
+    return this->counts[level];
+}
+
+std::size_t Partition::getCell(std::size_t level, std::size_t v) const
+{
+    return this->cells[level][v];
+}
+
+
+struct Customization
+{
+    Overlay *overlay;
+    std::size_t level;
+    std::size_t threads;
+    std::vector<std::pair<std::size_t, std::size_t> > sources;
+};
+
+void Overlay::work(std::size_t thread, void *context)
+{
+    Customization &customization = *(Customization *)context;
+    Overlay &overlay = *customization.overlay;
+    Level &level = overlay.levels[customization.level];
+    Workspace<double> space;
+    BinaryHeap<double> queue;
+    Blind<Interior> blind;
+
+    for (std::size_t i = thread; i < customization.sources.size();
+         i += customization.threads)
+    {
+        std::size_t cell = customization.sources[i].first,
+                    a = customization.sources[i].second,
+                    first = level.offsets[cell],
+                    entries = level.offsets[cell + 1] - first;
+        Interior interior(overlay, customization.level, cell);
+        solve<Interior, Blind<Interior>, BinaryHeap<double>,
+              double, Exhaust>(interior, blind, queue, space,
+                               level.vertices[first + a], 0);
+
+        for (std::size_t b = 0; b < entries; ++b)
+            level.weights[level.cliques[cell] + a * entries + b] =
+                space.getCosts(level.vertices[first + b]);
+    }
+}
+
+Overlay::Overlay(const Partition &partition, std::size_t threads)
+    : partition(partition), snapshot(partition.getSnapshot())
+{
+    std::size_t size = this->snapshot.size();
+    this->costs.resize(this->snapshot.countArcs());
+
+    for (std::size_t e = 0; e < this->costs.size(); ++e)
+        this->costs[e] = this->snapshot.cost(e);
+
+    this->levels.resize(partition.countLevels());
+
+    for (std::size_t k = 0; k < this->levels.size(); ++k)
+    {
+        Level &level = this->levels[k];
+        std::size_t cells = partition.countCells(k);
+        level.offsets.assign(cells + 1, 0);
+        level.positions.assign(size, -1);
+
+        for (std::size_t v = 0; v < size; ++v)
+        {
+            bool boundary = false;
+
+            for (std::size_t e = this->snapshot.begin(v);
+                 e < this->snapshot.end(v) && !boundary; ++e)
+                boundary = partition.getCell(k, this->snapshot.target(e)) !=
+                           partition.getCell(k, v);
+
+            for (std::size_t e = this->snapshot.reverseBegin(v);
+                 e < this->snapshot.reverseEnd(v) && !boundary; ++e)
+                boundary = partition.getCell(k, this->snapshot.source(e)) !=
+                           partition.getCell(k, v);
+
+            if (boundary)
+                level.positions[v] =
+                    level.offsets[partition.getCell(k, v) + 1]++;
+        }
+
+        level.cliques.assign(cells, 0);
+        std::size_t weights = 0;
+
+        for (std::size_t c = 0; c < cells; ++c)
+        {
+            std::size_t entries = level.offsets[c + 1];
+            level.cliques[c] = weights;
+            weights += entries * entries;
+            level.offsets[c + 1] += level.offsets[c];
+        }
+
+        level.vertices.resize(level.offsets[cells]);
+        level.weights.assign(weights, std::numeric_limits<double>::infinity());
+        level.dirty.assign(cells, 1);
+
+        for (std::size_t v = 0; v < size; ++v)
+            if (level.positions[v] != (std::size_t)-1)
+                level.vertices[level.offsets[partition.getCell(k, v)] +
+                               level.positions[v]] = v;
+    }
+
+    this->customize(threads);
+}
+
+void Overlay::updateCost(std::size_t srcID, std::size_t dstID,
+                         double cost)
+{
+    std::size_t src = this->snapshot.find(srcID),
+                dst = this->snapshot.find(dstID),
+                arc = -1;
+
+    if (src >= this->snapshot.size() || dst >= this->snapshot.size())
+        throw MISSING_ROUTE;
+
+    for (std::size_t e = this->snapshot.begin(src);
+         e < this->snapshot.end(src); ++e)
+        if (this->snapshot.target(e) == dst)
+            arc = e;
+
+    if (arc == (std::size_t)-1)
+        throw MISSING_ROUTE;
+
+    if (cost < this->snapshot.getWeight() *
+                   (this->snapshot.getPoint(src) ^
+                    this->snapshot.getPoint(dst)))
+        throw INVALID_ROUTE_2;
+
+    this->costs[arc] = cost;
+
+    for (std::size_t k = 0; k < this->levels.size(); ++k)
+        if (this->partition.getCell(k, src) ==
+            this->partition.getCell(k, dst))
+            this->levels[k].dirty[this->partition.getCell(k, src)] = 1;
+}
+
+void Overlay::customize(std::size_t threads)
+{
+    Customization customization;
+    customization.overlay = this;
+    customization.threads = countThreads(threads);
+
+    for (std::size_t k = 0; k < this->levels.size(); ++k)
+    {
+        Level &level = this->levels[k];
+        customization.level = k;
+        customization.sources.clear();
+
+        for (std::size_t c = 0; c < level.dirty.size(); ++c)
+            if (level.dirty[c])
+            {
+                for (std::size_t a = level.offsets[c];
+                     a < level.offsets[c + 1]; ++a)
+                    customization.sources.push_back(
+                        std::make_pair(c, a - level.offsets[c]));
+
+                level.dirty[c] = 0;
+            }
+
+        if (!customization.sources.empty())
+            runThreads(std::min(customization.threads,
+                                customization.sources.size()),
+                       Overlay::work, &customization);
+    }
+}
+
+std::size_t Overlay::countDirty() const
+{
+    std::size_t dirty = 0;
+
+    for (std::size_t k = 0; k < this->levels.size(); ++k)
+        dirty += std::count(this->levels[k].dirty.begin(),
+                            this->levels[k].dirty.end(), 1);
+
+    return dirty;
+}
+
+std::size_t Overlay::level(std::size_t v, std::size_t src,
+                           std::size_t dst) const
+{
+    for (std::size_t k = this->levels.size(); k; --k)
+    {
+        std::size_t cell = this->partition.getCell(k - 1, v);
+
+        if (cell != this->partition.getCell(k - 1, src) &&
+            cell != this->partition.getCell(k - 1, dst))
+            return k;
+    }
+
+    return 0;
+}
+
+const Partition &Overlay::getPartition() const
+{
+    return this->partition;
+}
+
+const Snapshot &Overlay::getSnapshot() const
+{
+    return this->snapshot;
+}
+
+
+Interior::Interior(const Overlay &overlay, std::size_t level,
+                   std::size_t cell)
+    : overlay(overlay)
+{
+    this->level = level;
+    this->cell = cell;
+}
+
+std::size_t Interior::size() const
+{
+    return this->overlay.getSnapshot().size();
+}
+
+
+void Multilevel::unpack(std::size_t src, std::size_t dst,
+                        std::size_t level, std::vector<std::size_t> &path)
+{
+    const Partition &partition = this->overlay.getPartition();
+
+    if (!level || partition.getCell(level - 1, src) !=
+                      partition.getCell(level - 1, dst))
+    {
+        path.push_back(dst);
+        return;
+    }
+
+    Interior interior(this->overlay, level - 1,
+                      partition.getCell(level - 1, src));
+    Blind<Interior> blind;
+    solve<Interior, Blind<Interior>, BinaryHeap<double>,
+          double, StopAtTarget>(interior, blind, this->queue,
+                                this->scratch, src, dst);
+
+    std::vector<std::size_t> hops;
+
+    for (std::size_t v = dst; v != src; v = this->scratch.prevs[v])
+        hops.push_back(v);
+
+    hops.push_back(src);
+    std::reverse(hops.begin(), hops.end());
+
+    for (std::size_t i = 1; i < hops.size(); ++i)
+        this->unpack(hops[i - 1], hops[i], level - 1, path);
+}
+
+Multilevel::Multilevel(const Overlay &overlay)
+    : overlay(overlay), snapshot(overlay.getSnapshot())
+{
+    this->src = this->dst = -1;
+    this->expanded = 0;
+}
+
+void Multilevel::findPath(std::size_t srcID, std::size_t dstID)
+{
+    this->src = this->snapshot.find(srcID);
+    this->dst = this->snapshot.find(dstID);
+    this->expanded = 0;
+
+    if (this->src >= this->snapshot.size() ||
+        this->dst >= this->snapshot.size())
+    {
+        this->src = this->dst = -1;
+        return;
+    }
+
+    Spherical<Multilevel> heuristic;
+    this->expanded =
+        solve<Multilevel, Spherical<Multilevel>, BinaryHeap<double>,
+              double, StopAtTarget>(*this, heuristic, this->queue,
+                                    this->space, this->src, this->dst);
+}
+
+std::size_t Multilevel::countExpanded() const
+{
+    return this->expanded;
+}
+
+std::vector<std::size_t> Multilevel::getPath()
+{
+    std::vector<std::size_t> hops, path;
+
+    if (this->getCosts() == std::numeric_limits<double>::infinity())
+        return path;
+
+    for (std::size_t v = this->dst; v != this->src;
+         v = this->space.prevs[v])
+        hops.push_back(v);
+
+    std::reverse(hops.begin(), hops.end());
+    path.push_back(this->src);
+
+    for (std::size_t i = 0; i < hops.size(); ++i)
+        this->unpack(path.back(), hops[i],
+                     this->overlay.level(path.back(), this->src,
+                                         this->dst),
+                     path);
+
+    for (std::size_t i = 0; i < path.size(); ++i)
+        path[i] = this->snapshot.getID(path[i]);
+
+    return path;
+}
+
+double Multilevel::getCosts() const
+{
+    if (this->dst == (std::size_t)-1)
+        return std::numeric_limits<double>::infinity();
+
+    return this->space.getCosts(this->dst);
+}
+
+std::size_t Multilevel::size() const
+{
+    return this->snapshot.size();
+}
+
+double Multilevel::getWeight() const
+{
+    return this->snapshot.getWeight();
+}
+
+const Point &Multilevel::getPoint(std::size_t v) const
+{
+    return this->snapshot.getPoint(v);
+}
+
+std::size_t Multilevel::getID(std::size_t v) const
+{
+    return this->snapshot.getID(v);
+}
\ No newline at end of file
@@ -0,0 +1,244 @@
+#ifndef OVERLAY_H
+#define OVERLAY_H
+
+#include "snapshot.h"
+#include "kernel.h"
+
+
+#ifndef MISSING_ROUTE
+#define MISSING_ROUTE 54
+#endif
+
+
+class Partition
+{
+    const Snapshot &snapshot;
+    std::vector<std::vector<std::size_t> > cells;
+    std::vector<std::size_t> counts;
+
+    void split(std::vector<std::size_t> &, std::size_t, std::size_t,
+               std::size_t, const std::vector<std::size_t> &);
+
+public:
+    Partition(const Snapshot &, std::size_t = 256, std::size_t = 3);
+
+    const Snapshot &getSnapshot() const;
+    std::size_t countLevels() const;
+    std::size_t countCells(std::size_t) const;
+    std::size_t getCell(std::size_t, std::size_t) const;
+};
+
+
+class Overlay
+{
+    struct Level
+    {
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> vertices;
+        std::vector<std::size_t> positions;
+        std::vector<std::size_t> cliques;
+        std::vector<double> weights;
+        std::vector<char> dirty;
+    };
+
+    const Partition &partition;
+    const Snapshot &snapshot;
+    std::vector<double> costs;
+    std::vector<Level> levels;
+
+    static void work(std::size_t, void *);
+
+public:
+    class Arcs
+    {
+        const Overlay &overlay;
+        std::size_t v;
+        std::size_t level;
+        std::size_t base;
+        std::size_t entry;
+        std::size_t entries;
+        std::size_t arc;
+        std::size_t last;
+
+        void skip()
+        {
+            while (this->entry < this->entries &&
+                   (this->entry == this->overlay.levels[this->level - 1]
+                                       .positions[this->v] ||
+                    this->cost() == Traits<double>::infinity()))
+                ++this->entry;
+
+            if (this->entry < this->entries || !this->level)
+                return;
+
+            while (this->arc < this->last &&
+                   this->overlay.partition.getCell(this->level - 1,
+                                                   this->target()) ==
+                       this->overlay.partition.getCell(this->level - 1,
+                                                       this->v))
+                ++this->arc;
+        }
+
+    public:
+        Arcs(const Overlay &overlay, std::size_t v, std::size_t level)
+            : overlay(overlay), v(v), level(level)
+        {
+            this->base = this->entry = this->entries = 0;
+            this->arc = overlay.snapshot.begin(v);
+            this->last = overlay.snapshot.end(v);
+
+            if (level)
+            {
+                const Level &cliques = overlay.levels[level - 1];
+                std::size_t cell = overlay.partition.getCell(level - 1, v);
+
+                if (cliques.positions[v] != (std::size_t)-1)
+                {
+                    this->entries = cliques.offsets[cell + 1] -
+                                    cliques.offsets[cell];
+                    this->base = cliques.cliques[cell] +
+                                 cliques.positions[v] * this->entries;
+                }
+            }
+
+            this->skip();
+        }
+
+        bool valid() const
+        {
+            return this->entry < this->entries || this->arc < this->last;
+        }
+
+        void next()
+        {
+            if (this->entry < this->entries)
+                ++this->entry;
+            else
+                ++this->arc;
+
+            this->skip();
+        }
+
+        std::size_t target() const
+        {
+            if (this->entry < this->entries)
+            {
+                const Level &cliques = this->overlay.levels[this->level - 1];
+
+                return cliques.vertices[
+                    cliques.offsets[this->overlay.partition.getCell(
+                        this->level - 1, this->v)] +
+                    this->entry];
+            }
+
+            return this->overlay.snapshot.target(this->arc);
+        }
+
+        double cost() const
+        {
+            if (this->entry < this->entries)
+                return this->overlay.levels[this->level - 1]
+                    .weights[this->base + this->entry];
+
+            return this->overlay.costs[this->arc];
+        }
+    };
+
+    Overlay(const Partition &, std::size_t = 0);
+
+    void updateCost(std::size_t, std::size_t, double);
+    void customize(std::size_t = 0);
+    std::size_t countDirty() const;
+    std::size_t level(std::size_t, std::size_t, std::size_t) const;
+    const Partition &getPartition() const;
+    const Snapshot &getSnapshot() const;
+};
+
+
+class Interior
+{
+    const Overlay &overlay;
+    std::size_t level;
+    std::size_t cell;
+
+public:
+    class Arcs
+    {
+        const Interior &graph;
+        Overlay::Arcs arcs;
+
+        void skip()
+        {
+            while (this->arcs.valid() &&
+                   this->graph.overlay.getPartition().getCell(
+                       this->graph.level, this->arcs.target()) !=
+                       this->graph.cell)
+                this->arcs.next();
+        }
+
+    public:
+        Arcs(const Interior &graph, std::size_t v)
+            : graph(graph), arcs(graph.overlay, v, graph.level)
+        {
+            this->skip();
+        }
+
+        bool valid() const { return this->arcs.valid(); }
+        void next() { this->arcs.next(), this->skip(); }
+        std::size_t target() const { return this->arcs.target(); }
+        double cost() const { return this->arcs.cost(); }
+    };
+
+    Interior(const Overlay &, std::size_t, std::size_t);
+
+    std::size_t size() const;
+};
+
+
+class Multilevel
+{
+    const Overlay &overlay;
+    const Snapshot &snapshot;
+    std::size_t src;
+    std::size_t dst;
+    std::size_t expanded;
+    Workspace<double> space;
+    Workspace<double> scratch;
+    BinaryHeap<double> queue;
+
+    void unpack(std::size_t, std::size_t, std::size_t,
+                std::vector<std::size_t> &);
+
+public:
+    class Arcs
+    {
+        Overlay::Arcs arcs;
+
+    public:
+        Arcs(const Multilevel &graph, std::size_t v)
+            : arcs(graph.overlay, v,
+                   graph.overlay.level(v, graph.src, graph.dst))
+        {
+        }
+
+        bool valid() const { return this->arcs.valid(); }
+        void next() { this->arcs.next(); }
+        std::size_t target() const { return this->arcs.target(); }
+        double cost() const { return this->arcs.cost(); }
+    };
+
+    Multilevel(const Overlay &);
+
+    void findPath(std::size_t, std::size_t);
+    std::size_t countExpanded() const;
+    std::vector<std::size_t> getPath();
+    double getCosts() const;
+
+    std::size_t size() const;
+    double getWeight() const;
+    const Point &getPoint(std::size_t) const;
+    std::size_t getID(std::size_t) const;
+};
+
+
+#endif
\ No newline at end of file
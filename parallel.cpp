@@ -0,0 +1,86 @@
+#include "parallel.h"
+#include <vector>
+#if __cplusplus >= 201103L
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+
+struct Lock
+{
+#if __cplusplus >= 201103L
+    std::mutex mutex;
+    std::condition_variable cond;
+#endif
+};
+
+
+Barrier::Barrier(std::size_t threads)
+{
+    this->threads = threads;
+    this->waiting = 0;
+    this->generation = 0;
+    this->lock = new Lock;
+}
+
+Barrier::~Barrier()
+{
+    delete this->lock;
+}
+
+void Barrier::wait()
+{
+#if __cplusplus >= 201103L
+    if (this->threads < 2)
+        return;
+
+    std::unique_lock<std::mutex> guard(this->lock->mutex);
+    std::size_t generation = this->generation;
+
+    if (++this->waiting == this->threads)
+    {
+        this->waiting = 0;
+        ++this->generation;
+        this->lock->cond.notify_all();
+        return;
+    }
+
+    while (generation == this->generation)
+        this->lock->cond.wait(guard);
+#endif
+}
+
+
+std::size_t countThreads(std::size_t threads)
+{
+#if __cplusplus >= 201103L
+    if (threads)
+        return threads;
+
+    threads = std::thread::hardware_concurrency();
+
+    return threads ? threads : 1;
+#else
+    return 1;
+#endif
+}
+
+void runThreads(std::size_t threads,
+                void (*work)(std::size_t, void *), void *context)
+{
+#if __cplusplus >= 201103L
+    std::vector<std::thread> workers;
+
+    for (std::size_t t = 1; t < threads; ++t)
+        workers.push_back(std::thread(work, t, context));
+
+    work(0, context);
+
+    for (std::size_t t = 0; t < workers.size(); ++t)
+        workers[t].join();
+#else
+    for (std::size_t t = 0; t < threads; ++t)
+        work(t, context);
+#endif
+}
\ No newline at end of file
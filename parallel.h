@@ -0,0 +1,33 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+
+
+struct Lock;
+
+
+class Barrier
+{
+    std::size_t threads;
+    std::size_t waiting;
+    std::size_t generation;
+    Lock *lock;
+
+    Barrier(const Barrier &);
+    Barrier &operator=(const Barrier &);
+
+public:
+    Barrier(std::size_t);
+    ~Barrier();
+
+    void wait();
+};
+
+
+std::size_t countThreads(std::size_t);
+void runThreads(std::size_t,
+                void (*)(std::size_t, void *), void *);
+
+
+#endif
\ No newline at end of file
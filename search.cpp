@@ -0,0 +1,200 @@
+#include "search.h"
+
+
+Options::Options()
+{
+    this->heuristic = HEURISTIC_SPHERICAL;
+    this->queue = QUEUE_BINARY;
+    this->cost = COST_DOUBLE;
+    this->stop = STOP_AT_TARGET;
+}
+
+
+template <class Heuristic>
+void Search::dispatch(Heuristic &heuristic, std::size_t src)
+{
+    switch (this->options.cost * 2 + this->options.queue)
+    {
+    case COST_DOUBLE * 2 + QUEUE_BINARY:
+        this->dispatch(heuristic, this->doubleHeap, this->doubles, src);
+        break;
+
+    case COST_DOUBLE * 2 + QUEUE_QUAD:
+        this->dispatch(heuristic, this->doubleQuad, this->doubles, src);
+        break;
+
+    case COST_FLOAT * 2 + QUEUE_BINARY:
+        this->dispatch(heuristic, this->floatHeap, this->floats, src);
+        break;
+
+    case COST_FLOAT * 2 + QUEUE_QUAD:
+        this->dispatch(heuristic, this->floatQuad, this->floats, src);
+        break;
+
+    case COST_FIXED * 2 + QUEUE_BINARY:
+        this->dispatch(heuristic, this->fixedHeap, this->fixeds, src);
+        break;
+
+    case COST_FIXED * 2 + QUEUE_QUAD:
+        this->dispatch(heuristic, this->fixedQuad, this->fixeds, src);
+        break;
+
+    default:
+        throw INVALID_OPTIONS;
+    }
+}
+
+template <class Heuristic, class Queue, class Cost>
+void Search::dispatch(Heuristic &heuristic, Queue &queue,
+                      Workspace<Cost> &space, std::size_t src)
+{
+    if (this->options.stop == STOP_NEVER)
+        this->expanded = solve<Snapshot, Heuristic, Queue, Cost, Exhaust>(
+            this->snapshot, heuristic, queue, space, src, this->dst);
+    else
+        this->expanded = solve<Snapshot, Heuristic, Queue, Cost, StopAtTarget>(
+            this->snapshot, heuristic, queue, space, src, this->dst);
+}
+
+template <class Cost>
+std::vector<std::size_t> Search::trace(const Workspace<Cost> &space,
+                                       std::size_t curr) const
+{
+    std::vector<std::size_t> path;
+
+    if (!space.seen(curr) || space.costs[curr] == Traits<Cost>::infinity())
+        return path;
+
+    while (curr != (std::size_t)-1)
+    {
+        path.push_back(this->snapshot.getID(curr));
+        curr = space.prevs[curr];
+    }
+
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
+
+
+Search::Search(const Snapshot &snapshot)
+    : snapshot(snapshot)
+{
+    this->landmarks = NULL;
+    this->custom.function = NULL;
+    this->custom.context = NULL;
+    this->dst = -1;
+    this->expanded = 0;
+}
+
+void Search::updateLandmarks(const Landmarks *landmarks)
+{
+    this->landmarks = landmarks;
+}
+
+void Search::updateHeuristic(double (*function)(std::size_t, std::size_t,
+                                                void *),
+                             void *context)
+{
+    this->custom.function = function;
+    this->custom.context = context;
+}
+
+void Search::findPath(std::size_t srcID, std::size_t dstID,
+                      const Options &options)
+{
+    this->dst = -1;
+    this->expanded = 0;
+
+    if (options.heuristic < HEURISTIC_NONE ||
+        options.heuristic > HEURISTIC_CUSTOM ||
+        options.queue < QUEUE_BINARY || options.queue > QUEUE_QUAD ||
+        options.cost < COST_DOUBLE || options.cost > COST_FIXED ||
+        options.stop < STOP_AT_TARGET || options.stop > STOP_NEVER)
+        throw INVALID_OPTIONS;
+
+    if ((options.heuristic == HEURISTIC_ALT && !this->landmarks) ||
+        (options.heuristic == HEURISTIC_CUSTOM && !this->custom.function))
+        throw MISSING_HEURISTIC;
+
+    std::size_t src = this->snapshot.find(srcID);
+    this->options = options;
+    this->dst = this->snapshot.find(dstID);
+
+    if (src >= this->snapshot.size() || this->dst >= this->snapshot.size())
+    {
+        this->dst = -1;
+        return;
+    }
+
+    if (options.heuristic == HEURISTIC_NONE)
+    {
+        Blind<Snapshot> heuristic;
+        this->dispatch(heuristic, src);
+    }
+    else if (options.heuristic == HEURISTIC_SPHERICAL)
+    {
+        Spherical<Snapshot> heuristic;
+        this->dispatch(heuristic, src);
+    }
+    else if (options.heuristic == HEURISTIC_ALT)
+    {
+        Tabled<Snapshot, Landmarks> heuristic(this->landmarks);
+        this->dispatch(heuristic, src);
+    }
+    else
+    {
+        this->dispatch(this->custom, src);
+    }
+}
+
+std::size_t Search::countExpanded() const
+{
+    return this->expanded;
+}
+
+std::vector<std::size_t> Search::getPath() const
+{
+    if (this->dst == (std::size_t)-1)
+        return std::vector<std::size_t>();
+
+    return this->getPath(this->snapshot.getID(this->dst));
+}
+
+std::vector<std::size_t> Search::getPath(std::size_t ID) const
+{
+    std::size_t index = this->snapshot.find(ID);
+
+    if (this->dst == (std::size_t)-1 || index >= this->snapshot.size())
+        return std::vector<std::size_t>();
+
+    if (this->options.cost == COST_FLOAT)
+        return this->trace(this->floats, index);
+    else if (this->options.cost == COST_FIXED)
+        return this->trace(this->fixeds, index);
+    else
+        return this->trace(this->doubles, index);
+}
+
+double Search::getCosts() const
+{
+    if (this->dst == (std::size_t)-1)
+        return std::numeric_limits<double>::infinity();
+
+    return this->getCosts(this->snapshot.getID(this->dst));
+}
+
+double Search::getCosts(std::size_t ID) const
+{
+    std::size_t index = this->snapshot.find(ID);
+
+    if (this->dst == (std::size_t)-1 || index >= this->snapshot.size())
+        return std::numeric_limits<double>::infinity();
+
+    if (this->options.cost == COST_FLOAT)
+        return this->floats.getCosts(index);
+    else if (this->options.cost == COST_FIXED)
+        return this->fixeds.getCosts(index);
+    else
+        return this->doubles.getCosts(index);
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "snapshot.h"
+#include "landmark.h"
+#include "kernel.h"
+
+
+#ifndef MISSING_HEURISTIC
+#define MISSING_HEURISTIC 41
+#endif
+
+#ifndef INVALID_OPTIONS
+#define INVALID_OPTIONS 42
+#endif
+
+#ifndef HEURISTIC_NONE
+#define HEURISTIC_NONE 0
+#endif
+
+#ifndef HEURISTIC_SPHERICAL
+#define HEURISTIC_SPHERICAL 1
+#endif
+
+#ifndef HEURISTIC_ALT
+#define HEURISTIC_ALT 2
+#endif
+
+#ifndef HEURISTIC_CUSTOM
+#define HEURISTIC_CUSTOM 3
+#endif
+
+#ifndef QUEUE_BINARY
+#define QUEUE_BINARY 0
+#endif
+
+#ifndef QUEUE_QUAD
+#define QUEUE_QUAD 1
+#endif
+
+#ifndef COST_DOUBLE
+#define COST_DOUBLE 0
+#endif
+
+#ifndef COST_FLOAT
+#define COST_FLOAT 1
+#endif
+
+#ifndef COST_FIXED
+#define COST_FIXED 2
+#endif
+
+#ifndef STOP_AT_TARGET
+#define STOP_AT_TARGET 0
+#endif
+
+#ifndef STOP_NEVER
+#define STOP_NEVER 1
+#endif
+
+
+struct Options
+{
+    int heuristic;
+    int queue;
+    int cost;
+    int stop;
+
+    Options();
+};
+
+
+class Search
+{
+    const Snapshot &snapshot;
+    const Landmarks *landmarks;
+    Custom<Snapshot> custom;
+    Options options;
+    std::size_t dst;
+    std::size_t expanded;
+    Workspace<double> doubles;
+    Workspace<float> floats;
+    Workspace<std::size_t> fixeds;
+    BinaryHeap<double> doubleHeap;
+    BinaryHeap<float> floatHeap;
+    BinaryHeap<std::size_t> fixedHeap;
+    QuadHeap<double> doubleQuad;
+    QuadHeap<float> floatQuad;
+    QuadHeap<std::size_t> fixedQuad;
+
+    template <class Heuristic>
+    void dispatch(Heuristic &, std::size_t);
+    template <class Heuristic, class Queue, class Cost>
+    void dispatch(Heuristic &, Queue &, Workspace<Cost> &,
+                  std::size_t);
+    template <class Cost>
+    std::vector<std::size_t> trace(const Workspace<Cost> &,
+                                   std::size_t) const;
+
+public:
+    Search(const Snapshot &);
+
+    void updateLandmarks(const Landmarks *);
+    void updateHeuristic(double (*)(std::size_t, std::size_t, void *),
+                         void *);
+    void findPath(std::size_t, std::size_t,
+                  const Options & = Options());
+    std::size_t countExpanded() const;
+    std::vector<std::size_t> getPath() const;
+    std::vector<std::size_t> getPath(std::size_t) const;
+    double getCosts() const;
+    double getCosts(std::size_t) const;
+};
+
+
+#endif
\ No newline at end of file
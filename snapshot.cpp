@@ -0,0 +1,141 @@
+#include "snapshot.h"
+#include <algorithm>
+
+
+Snapshot::Snapshot()
+{
+    this->weight = 0;
+    this->offsets.push_back(0);
+    this->reverseOffsets.push_back(0);
+}
+
+Snapshot::Snapshot(const Graph &graph)
+{
+    std::vector<Route> routes;
+    this->weight = graph.getWeight();
+    graph.copy(this->IDs, this->points, routes, this->costs);
+
+    std::size_t size = this->IDs.size();
+    this->offsets.assign(size + 1, 0);
+    this->reverseOffsets.assign(size + 1, 0);
+    this->targets.resize(routes.size());
+    this->sources.resize(routes.size());
+    this->reverseCosts.resize(routes.size());
+    std::vector<std::size_t> srcs(routes.size());
+
+    for (std::size_t i = 0; i < routes.size(); ++i)
+    {
+        srcs[i] = this->find(routes[i].srcID);
+        this->targets[i] = this->find(routes[i].dstID);
+        ++this->offsets[srcs[i] + 1];
+        ++this->reverseOffsets[this->targets[i] + 1];
+    }
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        this->offsets[i + 1] += this->offsets[i];
+        this->reverseOffsets[i + 1] += this->reverseOffsets[i];
+    }
+
+    std::vector<std::size_t> cursors(this->reverseOffsets.begin(),
+                                     this->reverseOffsets.end() - 1);
+
+    for (std::size_t i = 0; i < routes.size(); ++i)
+    {
+        std::size_t e = cursors[this->targets[i]]++;
+        this->sources[e] = srcs[i];
+        this->reverseCosts[e] = this->costs[i];
+    }
+}
+
+Snapshot Snapshot::reverse() const
+{
+    Snapshot snapshot;
+    snapshot.weight = this->weight;
+    snapshot.IDs = this->IDs;
+    snapshot.points = this->points;
+    snapshot.offsets = this->reverseOffsets;
+    snapshot.targets = this->sources;
+    snapshot.costs = this->reverseCosts;
+    snapshot.reverseOffsets = this->offsets;
+    snapshot.sources = this->targets;
+    snapshot.reverseCosts = this->costs;
+
+    return snapshot;
+}
+
+std::size_t Snapshot::size() const
+{
+    return this->IDs.size();
+}
+
+std::size_t Snapshot::countArcs() const
+{
+    return this->targets.size();
+}
+
+std::size_t Snapshot::find(std::size_t ID) const
+{
+    std::vector<std::size_t>::const_iterator iter =
+        std::lower_bound(this->IDs.begin(), this->IDs.end(), ID);
+
+    if (iter == this->IDs.end() || *iter != ID)
+        return this->IDs.size();
+
+    return iter - this->IDs.begin();
+}
+
+std::size_t Snapshot::getID(std::size_t index) const
+{
+    return this->IDs[index];
+}
+
+const Point &Snapshot::getPoint(std::size_t index) const
+{
+    return this->points[index];
+}
+
+double Snapshot::getWeight() const
+{
+    return this->weight;
+}
+
+std::size_t Snapshot::begin(std::size_t index) const
+{
+    return this->offsets[index];
+}
+
+std::size_t Snapshot::end(std::size_t index) const
+{
+    return this->offsets[index + 1];
+}
+
+std::size_t Snapshot::target(std::size_t arc) const
+{
+    return this->targets[arc];
+}
+
+double Snapshot::cost(std::size_t arc) const
+{
+    return this->costs[arc];
+}
+
+std::size_t Snapshot::reverseBegin(std::size_t index) const
+{
+    return this->reverseOffsets[index];
+}
+
+std::size_t Snapshot::reverseEnd(std::size_t index) const
+{
+    return this->reverseOffsets[index + 1];
+}
+
+std::size_t Snapshot::source(std::size_t arc) const
+{
+    return this->sources[arc];
+}
+
+double Snapshot::reverseCost(std::size_t arc) const
+{
+    return this->reverseCosts[arc];
+}
\ No newline at end of file
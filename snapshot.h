@@ -0,0 +1,64 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "graph.h"
+
+
+class Snapshot
+{
+    double weight;
+    std::vector<std::size_t> IDs;
+    std::vector<Point> points;
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> targets;
+    std::vector<double> costs;
+    std::vector<std::size_t> reverseOffsets;
+    std::vector<std::size_t> sources;
+    std::vector<double> reverseCosts;
+
+public:
+    class Arcs
+    {
+        const Snapshot &snapshot;
+        std::size_t arc;
+        std::size_t last;
+
+    public:
+        Arcs(const Snapshot &snapshot, std::size_t index)
+            : snapshot(snapshot)
+        {
+            this->arc = snapshot.offsets[index];
+            this->last = snapshot.offsets[index + 1];
+        }
+
+        bool valid() const { return this->arc < this->last; }
+        void next() { ++this->arc; }
+        std::size_t target() const { return this->snapshot.targets[this->arc]; }
+        double cost() const { return this->snapshot.costs[this->arc]; }
+    };
+
+    Snapshot();
+    Snapshot(const Graph &);
+
+    Snapshot reverse() const;
+
+    std::size_t size() const;
+    std::size_t countArcs() const;
+    std::size_t find(std::size_t) const;
+    std::size_t getID(std::size_t) const;
+    const Point &getPoint(std::size_t) const;
+    double getWeight() const;
+
+    std::size_t begin(std::size_t) const;
+    std::size_t end(std::size_t) const;
+    std::size_t target(std::size_t) const;
+    double cost(std::size_t) const;
+
+    std::size_t reverseBegin(std::size_t) const;
+    std::size_t reverseEnd(std::size_t) const;
+    std::size_t source(std::size_t) const;
+    double reverseCost(std::size_t) const;
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include "stepping.h"
+#include "parallel.h"
+#include <limits>
+#include <algorithm>
+
+
+typedef std::vector<std::size_t> Bucket;
+
+struct Request
+{
+    std::size_t target;
+    std::size_t source;
+    double costs;
+
+    Request(std::size_t, std::size_t, double);
+};
+
+typedef std::vector<Request> Requests;
+
+struct Steps
+{
+    const Snapshot *snapshot;
+    double delta;
+    std::size_t threads;
+    double *distances;
+    std::size_t *prevs;
+    Barrier *barrier;
+    std::vector<std::map<std::size_t, Bucket> > buckets;
+    std::vector<std::vector<Requests> > requests;
+    std::vector<std::size_t> mins;
+    std::vector<char> busy;
+
+    std::size_t index(double) const;
+    void relax(std::size_t, const Bucket &, bool);
+    void distribute(std::size_t);
+    void settle(std::size_t);
+};
+
+
+Request::Request(std::size_t target, std::size_t source, double costs)
+{
+    this->target = target;
+    this->source = source;
+    this->costs = costs;
+}
+
+
+std::size_t Steps::index(double costs) const
+{
+    return (std::size_t)(costs / this->delta);
+}
+
+void Steps::relax(std::size_t t, const Bucket &frontier, bool light)
+{
+    const Snapshot &snapshot = *this->snapshot;
+
+    for (std::size_t i = 0; i < frontier.size(); ++i)
+    {
+        std::size_t v = frontier[i];
+        double costs = this->distances[v];
+
+        for (std::size_t e = snapshot.begin(v);
+             e < snapshot.end(v); ++e)
+        {
+            double cost = snapshot.cost(e);
+
+            if ((cost <= this->delta) != light)
+                continue;
+
+            std::size_t w = snapshot.target(e);
+
+            if (costs + cost < this->distances[w])
+                this->requests[t][w % this->threads].push_back(
+                    Request(w, v, costs + cost));
+        }
+    }
+
+    this->barrier->wait();
+    this->distribute(t);
+    this->barrier->wait();
+
+    for (std::size_t o = 0; o < this->threads; ++o)
+        this->requests[t][o].clear();
+}
+
+void Steps::distribute(std::size_t t)
+{
+    for (std::size_t f = 0; f < this->threads; ++f)
+    {
+        const Requests &requests = this->requests[f][t];
+
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {
+            const Request &request = requests[i];
+
+            if (request.costs < this->distances[request.target])
+            {
+                this->distances[request.target] = request.costs;
+                this->prevs[request.target] = request.source;
+                this->buckets[t][this->index(request.costs)].push_back(
+                    request.target);
+            }
+        }
+    }
+}
+
+void Steps::settle(std::size_t t)
+{
+    std::size_t none = -1;
+    Bucket frontier, current, removed;
+
+    while (true)
+    {
+        this->mins[t] = this->buckets[t].empty()
+                            ? none
+                            : this->buckets[t].begin()->first;
+        this->barrier->wait();
+        std::size_t b = *std::min_element(this->mins.begin(),
+                                          this->mins.end());
+
+        if (b == none)
+            break;
+
+        while (true)
+        {
+            frontier.clear();
+            current.clear();
+            std::map<std::size_t, Bucket>::iterator iter =
+                this->buckets[t].find(b);
+
+            if (iter != this->buckets[t].end())
+            {
+                frontier.swap(iter->second);
+                this->buckets[t].erase(iter);
+            }
+
+            for (std::size_t i = 0; i < frontier.size(); ++i)
+                if (this->index(this->distances[frontier[i]]) == b)
+                    current.push_back(frontier[i]);
+
+            removed.insert(removed.end(),
+                           current.begin(), current.end());
+            this->relax(t, current, true);
+            this->busy[t] = this->buckets[t].count(b) ? 1 : 0;
+            this->barrier->wait();
+
+            if (std::find(this->busy.begin(), this->busy.end(), 1) ==
+                this->busy.end())
+                break;
+        }
+
+        std::sort(removed.begin(), removed.end());
+        removed.erase(std::unique(removed.begin(), removed.end()),
+                      removed.end());
+        this->relax(t, removed, false);
+        removed.clear();
+    }
+}
+
+static void work(std::size_t t, void *context)
+{
+    Steps &steps = *(Steps *)context;
+    steps.settle(t);
+}
+
+
+Stepping::Stepping(const Snapshot &snapshot, double delta,
+                   std::size_t threads)
+    : snapshot(snapshot)
+{
+    if (delta <= 0)
+    {
+        delta = 0;
+
+        for (std::size_t e = 0; e < snapshot.countArcs(); ++e)
+            delta += snapshot.cost(e);
+
+        if (snapshot.countArcs())
+            delta /= snapshot.countArcs();
+
+        if (delta <= 0)
+            delta = 1;
+    }
+
+    this->delta = delta;
+    this->threads = ::countThreads(threads);
+}
+
+void Stepping::findCosts(std::size_t srcID)
+{
+    std::size_t size = this->snapshot.size(),
+                src = this->snapshot.find(srcID);
+    this->costs.assign(size, std::numeric_limits<double>::infinity());
+    this->prevs.assign(size, -1);
+
+    if (src < size)
+    {
+        Barrier barrier(this->threads);
+        Steps steps;
+        steps.snapshot = &this->snapshot;
+        steps.delta = this->delta;
+        steps.threads = this->threads;
+        steps.distances = &this->costs[0];
+        steps.prevs = &this->prevs[0];
+        steps.barrier = &barrier;
+        steps.buckets.resize(this->threads);
+        steps.requests.assign(this->threads,
+                              std::vector<Requests>(this->threads));
+        steps.mins.resize(this->threads);
+        steps.busy.resize(this->threads);
+        this->costs[src] = 0;
+        steps.buckets[src % this->threads][0].push_back(src);
+        runThreads(this->threads, work, &steps);
+    }
+}
+
+double Stepping::getDelta() const
+{
+    return this->delta;
+}
+
+std::size_t Stepping::countThreads() const
+{
+    return this->threads;
+}
+
+const std::vector<double> &Stepping::getCosts() const
+{
+    return this->costs;
+}
+
+const std::vector<std::size_t> &Stepping::getPrevs() const
+{
+    return this->prevs;
+}
+
+double Stepping::getCosts(std::size_t dstID) const
+{
+    std::size_t dst = this->snapshot.find(dstID);
+
+    if (dst >= this->costs.size())
+        return std::numeric_limits<double>::infinity();
+
+    return this->costs[dst];
+}
+
+std::vector<std::size_t> Stepping::getPath(std::size_t dstID) const
+{
+    std::vector<std::size_t> path;
+    std::size_t curr = this->snapshot.find(dstID);
+
+    if (curr >= this->costs.size() ||
+        this->costs[curr] == std::numeric_limits<double>::infinity())
+        return path;
+
+    while (curr != (std::size_t)-1)
+    {
+        path.push_back(this->snapshot.getID(curr));
+        curr = this->prevs[curr];
+    }
+
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef STEPPING_H
+#define STEPPING_H
+
+#include "snapshot.h"
+
+
+class Stepping
+{
+    const Snapshot &snapshot;
+    double delta;
+    std::size_t threads;
+    std::vector<double> costs;
+    std::vector<std::size_t> prevs;
+
+public:
+    Stepping(const Snapshot &, double = 0,
+             std::size_t = 0);
+
+    void findCosts(std::size_t);
+    double getDelta() const;
+    std::size_t countThreads() const;
+    const std::vector<double> &getCosts() const;
+    const std::vector<std::size_t> &getPrevs() const;
+    double getCosts(std::size_t) const;
+    std::vector<std::size_t> getPath(std::size_t) const;
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,964 @@
+#include "graph.h"
+#include "snapshot.h"
+#include "landmark.h"
+#include "search.h"
+#include "stepping.h"
+#include "traffic.h"
+#include "alternative.h"
+#include "overlay.h"
+#include "compressed.h"
+#include "mapped.h"
+#include "distributed.h"
+#include "parallel.h"
+#include "metrics.h"
+#include "writer.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <algorithm>
+#if __cplusplus >= 201103L
+#include <chrono>
+#endif
+
+
+static const double INF = std::numeric_limits<double>::infinity();
+static const char *FILE_NAME = "test.bin";
+static const char *PATH_NAME = "paths.bin";
+static const char *DAMAGED_NAME = "damaged.bin";
+
+static std::size_t seed, checks, failures;
+
+
+static double now()
+{
+#if __cplusplus >= 201103L
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#elif defined(__unix__) || defined(__APPLE__)
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec + time.tv_nsec / 1e9;
+#else
+    return (double)std::clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static double uniform()
+{
+    return (double)std::rand() / RAND_MAX;
+}
+
+static bool near(double expected, double actual, double tolerance)
+{
+    if (expected == INF || actual == INF)
+        return expected == actual;
+
+    return actual >= expected - tolerance && actual <= expected + tolerance;
+}
+
+static bool bounded(double expected, double actual, double tolerance)
+{
+    return !(actual < expected * (1 - 1e-9)) &&
+           near(expected, actual, tolerance);
+}
+
+static void expect(bool passed, const char *engine, std::size_t srcID,
+                   std::size_t dstID, double expected, double actual)
+{
+    ++checks;
+
+    if (passed)
+        return;
+
+    if (++failures <= 20)
+        std::cout << "  FAIL seed " << seed << ", " << engine << ", "
+                  << srcID << " -> " << dstID << ": expected "
+                  << std::setprecision(17) << expected << ", got "
+                  << actual << std::endl;
+}
+
+
+static void build(Graph &graph, std::size_t size)
+{
+    std::vector<Point> points;
+    double scale = graph.getWeight() ? graph.getWeight() : 6371;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        double phi = 1.0 + 0.2 * uniform(), theta = 0.2 * uniform();
+        points.push_back(Point(phi, theta));
+        graph.insertPoint(7 * i + 3, phi, theta);
+    }
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        std::vector<std::pair<double, std::size_t> > nearest;
+
+        for (std::size_t j = 0; j < size; ++j)
+            if (j != i)
+                nearest.push_back(
+                    std::make_pair(points[i] ^ points[j], j));
+
+        std::size_t degree = std::min<std::size_t>(3, nearest.size());
+        std::partial_sort(nearest.begin(), nearest.begin() + degree,
+                          nearest.end());
+
+        for (std::size_t k = 0; k < degree; ++k)
+        {
+            std::size_t j = nearest[k].second;
+            double bound = scale * nearest[k].first,
+                   cost = std::rand() % 4 ? bound * (1 + 0.5 * uniform())
+                          : graph.getWeight() ? bound
+                                              : 0;
+            graph.insertRoute(7 * i + 3, 7 * j + 3, cost);
+
+            if (std::rand() % 8)
+                graph.insertRoute(7 * j + 3, 7 * i + 3, cost);
+        }
+    }
+
+    for (std::size_t k = 0; size > 1 && k < size / 20; ++k)
+    {
+        std::size_t i = std::rand() % size, j = std::rand() % size;
+
+        if (i != j)
+            graph.insertRoute(7 * i + 3, 7 * j + 3,
+                              scale * (points[i] ^ points[j]) *
+                                  (1 + uniform()));
+    }
+}
+
+static double dijkstra(const Snapshot &snapshot, std::size_t srcID,
+                       std::size_t dstID)
+{
+    typedef std::pair<double, std::size_t> Entry;
+    std::size_t src = snapshot.find(srcID), dst = snapshot.find(dstID);
+    std::vector<double> costs(snapshot.size(), INF);
+    std::priority_queue<Entry, std::vector<Entry>,
+                        std::greater<Entry> >
+        queue;
+
+    if (src >= snapshot.size() || dst >= snapshot.size())
+        return INF;
+
+    costs[src] = 0;
+    queue.push(Entry(0, src));
+
+    while (!queue.empty())
+    {
+        Entry entry = queue.top();
+        queue.pop();
+
+        if (entry.second == dst)
+            return entry.first;
+
+        if (entry.first > costs[entry.second])
+            continue;
+
+        for (std::size_t e = snapshot.begin(entry.second);
+             e < snapshot.end(entry.second); ++e)
+            if (entry.first + snapshot.cost(e) < costs[snapshot.target(e)])
+            {
+                costs[snapshot.target(e)] = entry.first + snapshot.cost(e);
+                queue.push(Entry(costs[snapshot.target(e)],
+                                 snapshot.target(e)));
+            }
+    }
+
+    return INF;
+}
+
+static double measure(const Graph &graph, const std::vector<std::size_t> &path,
+                      std::size_t srcID, std::size_t dstID)
+{
+    if (path.empty() || path.front() != srcID || path.back() != dstID)
+        return INF;
+
+    double costs = 0;
+
+    for (std::size_t i = 1; i < path.size(); ++i)
+        costs += graph.getCost(path[i - 1], path[i]);
+
+    return costs;
+}
+
+static double spherical(std::size_t ID, std::size_t dstID, void *context)
+{
+    const Snapshot &snapshot = *(const Snapshot *)context;
+    double dot = snapshot.getPoint(snapshot.find(ID)) *
+                 snapshot.getPoint(snapshot.find(dstID));
+
+    return snapshot.getWeight() * std::acos(std::max(-1.0, std::min(1.0, dot)));
+}
+
+
+static double timed(const Snapshot &snapshot, const Traffic &traffic,
+                    std::size_t srcID, std::size_t dstID, double departure)
+{
+    typedef std::pair<double, std::size_t> Entry;
+    std::size_t src = snapshot.find(srcID), dst = snapshot.find(dstID);
+    std::vector<double> arrivals(snapshot.countArcs(), INF);
+    std::vector<std::size_t> tails(snapshot.countArcs());
+    std::priority_queue<Entry, std::vector<Entry>,
+                        std::greater<Entry> >
+        queue;
+    std::map<Turn, double> turns;
+    std::vector<Turn> keys;
+    std::vector<double> costs;
+    const Profiles &profiles = traffic.getProfiles();
+    traffic.copy(keys, costs);
+
+    if (src >= snapshot.size() || dst >= snapshot.size())
+        return INF;
+
+    if (src == dst)
+        return 0;
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        turns[keys[i]] = costs[i];
+
+    for (std::size_t v = 0; v < snapshot.size(); ++v)
+        for (std::size_t e = snapshot.begin(v); e < snapshot.end(v); ++e)
+            tails[e] = v;
+
+    for (std::size_t e = snapshot.begin(src); e < snapshot.end(src); ++e)
+        queue.push(Entry(departure - 1, e));
+
+    while (!queue.empty())
+    {
+        Entry entry = queue.top();
+        queue.pop();
+        std::size_t e = entry.second, u = tails[e], v = snapshot.target(e);
+        double leave = departure;
+
+        if (entry.first >= departure)
+        {
+            if (entry.first > arrivals[e])
+                continue;
+
+            if (v == dst)
+                return entry.first - departure;
+
+            leave = entry.first;
+        }
+        else
+            v = u, u = -1;
+
+        for (std::size_t f = snapshot.begin(v); f < snapshot.end(v); ++f)
+        {
+            if (u == (std::size_t)-1 && f != e)
+                continue;
+
+            std::size_t w = snapshot.target(f);
+            std::map<Turn, double>::const_iterator iter =
+                u == (std::size_t)-1
+                    ? turns.end()
+                    : turns.find(Turn(snapshot.getID(u), snapshot.getID(v),
+                                      snapshot.getID(w)));
+            double turn = iter == turns.end() ? 0 : iter->second;
+
+            if (turn == INF)
+                continue;
+
+            std::size_t profile = traffic.getProfile(snapshot.getID(v),
+                                                     snapshot.getID(w));
+            double arrival = leave + turn +
+                             snapshot.cost(f) *
+                                 (profile ? profiles.factor(profile,
+                                                            leave + turn)
+                                          : 1);
+
+            if (arrival < arrivals[f])
+            {
+                arrivals[f] = arrival;
+                queue.push(Entry(arrival, f));
+            }
+        }
+    }
+
+    return INF;
+}
+
+static void congest(const Graph &graph, const Snapshot &snapshot,
+                    Traffic &traffic)
+{
+    std::vector<std::size_t> profiles(1, 0);
+
+    for (std::size_t p = 0; p < 3; ++p)
+    {
+        std::vector<double> factors(96);
+        double amplitude = 2 * uniform(), phase = 6 * uniform();
+
+        for (std::size_t i = 0; i < factors.size(); ++i)
+            factors[i] = 1 + amplitude *
+                                 (1 + std::sin(phase + i * 6.283185 / 96)) /
+                                 2;
+
+        profiles.push_back(traffic.insertProfile(factors));
+    }
+
+    for (std::size_t v = 0; v < snapshot.size(); ++v)
+        for (std::size_t e = snapshot.begin(v); e < snapshot.end(v); ++e)
+        {
+            std::size_t srcID = snapshot.getID(v),
+                        dstID = snapshot.getID(snapshot.target(e));
+
+            if (std::rand() % 3 == 0)
+            {
+                try
+                {
+                    traffic.assignProfile(graph, srcID, dstID,
+                                          profiles[std::rand() % 4]);
+                }
+                catch (int code)
+                {
+                    expect(code == NON_FIFO_PROFILE, "profile", srcID,
+                           dstID, NON_FIFO_PROFILE, code);
+                }
+            }
+
+            if (std::rand() % 5 == 0 &&
+                snapshot.begin(snapshot.target(e)) <
+                    snapshot.end(snapshot.target(e)))
+            {
+                std::size_t w = snapshot.target(
+                    snapshot.begin(snapshot.target(e)) +
+                    std::rand() % (snapshot.end(snapshot.target(e)) -
+                                   snapshot.begin(snapshot.target(e))));
+                traffic.insertTurn(srcID, dstID, snapshot.getID(w),
+                                   std::rand() % 10 ? 100 * uniform()
+                                                    : INF);
+            }
+        }
+}
+
+static void damage(const Snapshot &snapshot)
+{
+    std::ifstream fin(FILE_NAME, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(fin)),
+                            std::istreambuf_iterator<char>());
+    fin.close();
+
+    for (std::size_t round = 0; round < 40 && !bytes.empty(); ++round)
+    {
+        std::vector<char> damaged = bytes;
+
+        if (round == 0)
+            damaged.resize(damaged.size() - 1);
+        else if (round == 1)
+            damaged.resize(damaged.size() / 2);
+        else
+            damaged[std::rand() % damaged.size()] ^=
+                (char)(1 << std::rand() % 8);
+
+        std::ofstream fout(DAMAGED_NAME, std::ios::binary);
+        fout.write(&damaged[0], damaged.size());
+        fout.close();
+
+        try
+        {
+            Mapped mapped(DAMAGED_NAME);
+            Paged paged(mapped);
+            expect(round > 1, "damaged", round, damaged.size(), INVALID_FILE,
+                   0);
+
+            for (std::size_t q = 0; q < 4; ++q)
+                paged.findPath(snapshot.getID(std::rand() % snapshot.size()),
+                               snapshot.getID(std::rand() % snapshot.size()));
+        }
+        catch (int code)
+        {
+            expect(code == INVALID_FILE, "damaged", round, damaged.size(),
+                   INVALID_FILE, code);
+        }
+    }
+
+    std::remove(DAMAGED_NAME);
+}
+
+static void replay(const std::vector<std::vector<std::size_t> > &paths,
+                   const std::vector<double> &costs)
+{
+    {
+        Writer writer(PATH_NAME, true, 64);
+
+        for (std::size_t i = 0; i < paths.size(); ++i)
+            writer.writePath(paths[i], costs[i]);
+    }
+
+    std::ifstream fin(PATH_NAME, std::ios::binary);
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(fin)),
+                                     std::istreambuf_iterator<char>());
+    std::size_t pos = 0;
+    fin.close();
+    std::remove(PATH_NAME);
+
+    for (std::size_t i = 0; i < paths.size(); ++i)
+    {
+        double read = -1;
+        std::vector<std::size_t> path;
+
+        try
+        {
+            path = readPath(bytes, pos, read);
+        }
+        catch (int code)
+        {
+            expect(false, "read path", i, code, costs[i], read);
+            return;
+        }
+
+        expect(path == paths[i] && read == costs[i], "read path",
+               paths[i].front(), paths[i].back(), costs[i], read);
+    }
+
+    expect(pos == bytes.size(), "read end", 0, 0, bytes.size(), pos);
+
+    if (bytes.empty())
+        return;
+
+    bytes.pop_back();
+    pos = 0;
+
+    try
+    {
+        for (std::size_t i = 0; i < paths.size(); ++i)
+        {
+            double read;
+            readPath(bytes, pos, read);
+        }
+
+        expect(false, "truncated", 0, 0, INVALID_PATH, 0);
+    }
+    catch (int code)
+    {
+        expect(code == INVALID_PATH, "truncated", 0, 0, INVALID_PATH, code);
+    }
+}
+
+
+static void compare(Graph &graph, std::size_t queries,
+                    const std::vector<std::size_t> &hot)
+{
+    Snapshot snapshot(graph);
+
+    if (!snapshot.size())
+        return;
+
+    Landmarks landmarks(snapshot, 4);
+    Search search(snapshot);
+    search.updateLandmarks(&landmarks);
+    search.updateHeuristic(spherical, &snapshot);
+    Stepping stepping(snapshot, 0, 2);
+    Traffic traffic, congested;
+    Journey journey(snapshot, traffic);
+    congest(graph, snapshot, congested);
+    Journey dynamic(snapshot, congested);
+    std::vector<std::vector<std::size_t> > paths;
+    std::vector<double> totals;
+    Alternatives alternatives(snapshot);
+    Partition partition(snapshot, 32, 2);
+    Overlay overlay(partition, 2);
+    Multilevel multilevel(overlay);
+    Compressed wide(snapshot), narrow(snapshot, COSTS_16BIT,
+                                      VECTORS_OCTAHEDRAL);
+    Compact compact(wide), tight(narrow);
+    Mapped::save(wide, FILE_NAME);
+    damage(snapshot);
+    Mapped mapped(FILE_NAME);
+    Paged paged(mapped);
+    Distributed distributed(snapshot, 3);
+    double largest = 0;
+
+    for (std::size_t e = 0; e < snapshot.countArcs(); ++e)
+        largest = std::max(largest, snapshot.cost(e));
+
+    for (std::size_t q = 0; q < queries; ++q)
+    {
+        std::size_t srcID = snapshot.getID(std::rand() % snapshot.size()),
+                    dstID = snapshot.getID(std::rand() % snapshot.size());
+
+        if (q % 2 && !hot.empty() &&
+            snapshot.find(hot[q / 2 % hot.size()]) < snapshot.size())
+            dstID = hot[q / 2 % hot.size()];
+
+        graph.initialize(srcID, dstID);
+        graph.findPath();
+        double oracle = graph.getCosts(), costs;
+        std::size_t hops = graph.getPath().size();
+
+        expect(near(dijkstra(snapshot, srcID, dstID), oracle, 1e-9 * oracle),
+               "dijkstra", srcID, dstID, dijkstra(snapshot, srcID, dstID),
+               oracle);
+
+        if (oracle < INF)
+        {
+            expect(near(oracle, measure(graph, graph.getPath(), srcID, dstID),
+                        1e-9 * oracle),
+                   "graph path", srcID, dstID, oracle,
+                   measure(graph, graph.getPath(), srcID, dstID));
+            paths.push_back(graph.getPath());
+            totals.push_back(oracle);
+        }
+
+        for (int variant = 0; variant < 48; ++variant)
+        {
+            Options options;
+            options.heuristic = variant % 4;
+            options.queue = variant / 4 % 2;
+            options.cost = variant / 8 % 3;
+            options.stop = variant / 24;
+            search.findPath(srcID, dstID, options);
+            double tolerance = options.cost == COST_DOUBLE  ? 1e-9 * oracle
+                               : options.cost == COST_FLOAT ? 1e-5 * oracle
+                                                            : hops / 1048576.0;
+            expect(near(oracle, search.getCosts(), tolerance), "search",
+                   srcID, dstID, oracle, search.getCosts());
+            expect(near(search.getCosts(),
+                        measure(graph, search.getPath(), srcID, dstID),
+                        tolerance + 1e-9 * oracle),
+                   "search path", srcID, dstID, search.getCosts(),
+                   measure(graph, search.getPath(), srcID, dstID));
+        }
+
+        for (int field = 0; field < 4; ++field)
+        {
+            Options options;
+            int *value[] = {&options.heuristic, &options.queue,
+                            &options.cost, &options.stop};
+            *value[field] = std::rand() % 2 ? -1 : 4;
+
+            try
+            {
+                search.findPath(srcID, dstID, options);
+                expect(false, "options", srcID, dstID, INVALID_OPTIONS, 0);
+            }
+            catch (int code)
+            {
+                expect(code == INVALID_OPTIONS, "options", srcID, dstID,
+                       INVALID_OPTIONS, code);
+            }
+
+            expect(search.getCosts() == INF && search.getPath().empty(),
+                   "options", srcID, dstID, INF, search.getCosts());
+        }
+
+        stepping.findCosts(srcID);
+        expect(near(oracle, stepping.getCosts(dstID), 1e-9 * oracle),
+               "stepping", srcID, dstID, oracle, stepping.getCosts(dstID));
+        expect(near(oracle, measure(graph, stepping.getPath(dstID), srcID,
+                                    dstID),
+                    1e-9 * oracle),
+               "stepping path", srcID, dstID, oracle,
+               measure(graph, stepping.getPath(dstID), srcID, dstID));
+
+        journey.findPath(srcID, dstID);
+        expect(near(oracle, journey.getCosts(), 1e-9 * oracle), "journey",
+               srcID, dstID, oracle, journey.getCosts());
+
+        double departure = 86400 * uniform(),
+               arrival = timed(snapshot, congested, srcID, dstID, departure);
+        dynamic.findPath(srcID, dstID, departure);
+        expect(near(arrival, dynamic.getCosts(), 1e-9 * arrival),
+               "dynamic journey", srcID, dstID, arrival, dynamic.getCosts());
+
+        alternatives.findPaths(srcID, dstID);
+        expect((oracle < INF) == (alternatives.size() > 0),
+               "alternatives", srcID, dstID, oracle, alternatives.size());
+
+        for (std::size_t i = 0; i < alternatives.size(); ++i)
+        {
+            costs = alternatives.getCosts(i);
+            expect(i ? costs >= alternatives.getCosts(i - 1) &&
+                           costs <= 1.5 * oracle * (1 + 1e-9)
+                     : near(oracle, costs, 1e-9 * oracle),
+                   "alternative", srcID, dstID, oracle, costs);
+            expect(near(costs, measure(graph, alternatives.getPath(i), srcID,
+                                       dstID),
+                        1e-9 * oracle),
+                   "alternative path", srcID, dstID, costs,
+                   measure(graph, alternatives.getPath(i), srcID, dstID));
+        }
+
+        multilevel.findPath(srcID, dstID);
+        expect(near(oracle, multilevel.getCosts(), 1e-9 * oracle),
+               "multilevel", srcID, dstID, oracle, multilevel.getCosts());
+        expect(near(oracle, measure(graph, multilevel.getPath(), srcID,
+                                    dstID),
+                    1e-9 * oracle),
+               "multilevel path", srcID, dstID, oracle,
+               measure(graph, multilevel.getPath(), srcID, dstID));
+
+        compact.findPath(srcID, dstID);
+        costs = compact.getCosts();
+        expect(bounded(oracle, costs, 2 * hops * largest / 4294967295.0 + 1e-9),
+               "compact", srcID, dstID, oracle, costs);
+        expect(measure(graph, compact.getPath(), srcID, dstID) <=
+                   costs + 1e-9 * oracle,
+               "compact path", srcID, dstID, costs,
+               measure(graph, compact.getPath(), srcID, dstID));
+
+        paged.findPath(srcID, dstID);
+        expect(paged.getCosts() == costs &&
+                   paged.getPath() == compact.getPath(),
+               "paged", srcID, dstID, costs, paged.getCosts());
+
+        tight.findPath(srcID, dstID);
+        costs = tight.getCosts();
+        expect(bounded(oracle, costs, 2 * hops * largest / 65535 + 1e-9),
+               "compact 16-bit", srcID, dstID, oracle, costs);
+
+        distributed.findPath(srcID, dstID);
+        expect(near(oracle, distributed.getCosts(), 1e-9 * oracle),
+               "distributed", srcID, dstID, oracle, distributed.getCosts());
+        expect(near(oracle, measure(graph, distributed.getPath(), srcID,
+                                    dstID),
+                    1e-9 * oracle),
+               "distributed path", srcID, dstID, oracle,
+               measure(graph, distributed.getPath(), srcID, dstID));
+
+        graph.initialize(srcID, dstID);
+        graph.findPath(0.5);
+        costs = graph.getCosts();
+        expect(bounded(oracle, costs, 0.5 * oracle + 1e-9) &&
+                   bounded(oracle, costs,
+                           (graph.getBound() - 1) * oracle + 1e-9),
+               "weighted", srcID, dstID, oracle, costs);
+
+        graph.initialize(srcID, dstID);
+        graph.findPath(2, 0);
+        expect(graph.countExpanded() == 0 &&
+                   (graph.getStatus() == PATH_CUT_OFF || srcID == dstID ||
+                    oracle == INF),
+               "deadline", srcID, dstID, 0, graph.countExpanded());
+
+        graph.initialize(srcID, dstID);
+        graph.findPath(2, 60);
+        expect(near(oracle, graph.getCosts(), 1e-9 * oracle) &&
+                   graph.getBound() == 1,
+               "anytime", srcID, dstID, oracle, graph.getCosts());
+
+        Limits limits;
+        CancelFlag cancel(true);
+        int mode = std::rand() % 3;
+
+        if (mode == 0)
+            limits.expansions = std::rand() % 20;
+        else if (mode == 1)
+            limits.cancel = &cancel;
+        else
+            limits.bytes = 64 * (std::rand() % 64);
+
+        graph.updateLimits(limits);
+        graph.initialize(srcID, dstID);
+        graph.findPath();
+        costs = graph.getCosts();
+
+        if (graph.getStatus() == PATH_CUT_OFF)
+        {
+            std::vector<std::size_t> partial = graph.getPartialPath();
+            expect(mode != 0 || graph.countExpanded() <= limits.expansions,
+                   "cut off", srcID, dstID, limits.expansions,
+                   graph.countExpanded());
+            expect(costs == INF ? graph.getPath().size() == 1
+                                : costs >= oracle - 1e-9 * oracle,
+                   "cut off costs", srcID, dstID, oracle, costs);
+            expect(!partial.empty() &&
+                       near(graph.getPartialCosts(),
+                            measure(graph, partial, srcID, partial.back()),
+                            1e-9 * graph.getPartialCosts()),
+                   "partial path", srcID, dstID, graph.getPartialCosts(),
+                   measure(graph, partial, srcID, partial.back()));
+        }
+        else
+            expect(near(oracle, costs, 1e-9 * oracle) &&
+                       (mode != 1 || srcID == dstID || oracle == INF),
+                   "limits", srcID, dstID, oracle, costs);
+
+        graph.updateLimits(Limits());
+    }
+
+    std::vector<std::size_t> large;
+    large.push_back(0);
+    large.push_back(~(std::size_t)0);
+    large.push_back(~(std::size_t)0 >> 1);
+    large.push_back((~(std::size_t)0 >> 1) + 2);
+    large.push_back(1);
+    large.push_back(~(std::size_t)0 - 6);
+    paths.push_back(large);
+    totals.push_back(INF);
+    replay(paths, totals);
+
+    for (std::size_t q = 0; q < queries / 5; ++q)
+    {
+        std::size_t src = std::rand() % snapshot.size();
+
+        if (snapshot.begin(src) == snapshot.end(src))
+            continue;
+
+        std::size_t arc = snapshot.begin(src) +
+                          std::rand() % (snapshot.end(src) - snapshot.begin(src));
+        std::size_t srcID = snapshot.getID(src),
+                    dstID = snapshot.getID(snapshot.target(arc));
+        double cost = snapshot.cost(arc) * (1 + 2 * uniform());
+        graph.insertRoute(srcID, dstID, cost);
+        overlay.updateCost(srcID, dstID, cost);
+        overlay.customize(2);
+        srcID = snapshot.getID(std::rand() % snapshot.size());
+        dstID = snapshot.getID(std::rand() % snapshot.size());
+        graph.initialize(srcID, dstID);
+        graph.findPath();
+        multilevel.findPath(srcID, dstID);
+        expect(near(graph.getCosts(), multilevel.getCosts(),
+                    1e-9 * graph.getCosts()),
+               "customized", srcID, dstID, graph.getCosts(),
+               multilevel.getCosts());
+    }
+
+    std::remove(FILE_NAME);
+}
+
+static void edit(Graph &graph, std::size_t &next, std::size_t edits)
+{
+    for (std::size_t k = 0; k < edits; ++k)
+    {
+        std::vector<std::size_t> IDs;
+        std::vector<Point> points;
+        std::vector<Route> routes;
+        std::vector<double> costs;
+        graph.copy(IDs, points, routes, costs);
+
+        if (IDs.size() < 2)
+            return;
+
+        std::size_t i = std::rand() % IDs.size(), j = std::rand() % IDs.size();
+        double bound = graph.getWeight() * (points[i] ^ points[j]);
+
+        switch (std::rand() % 6)
+        {
+        case 0:
+            graph.erasePoint(IDs[i]);
+            break;
+        case 1:
+            graph.insertPoint(next, 1.0 + 0.2 * uniform(), 0.2 * uniform());
+            graph.insertRoute(next, IDs[i], graph.getWeight());
+            graph.insertRoute(IDs[i], next, graph.getWeight());
+            next += 7;
+            break;
+        case 2:
+        case 3:
+            if (!routes.empty())
+            {
+                std::size_t r = std::rand() % routes.size();
+                graph.eraseRoute(routes[r].srcID, routes[r].dstID);
+            }
+            break;
+        default:
+            if (i == j)
+                break;
+
+            try
+            {
+                graph.insertRoute(IDs[i], IDs[j], bound * 0.999 - 1e-9);
+                expect(false, "check", IDs[i], IDs[j], bound,
+                       bound * 0.999 - 1e-9);
+            }
+            catch (int code)
+            {
+                expect(code == INVALID_ROUTE_2, "check", IDs[i], IDs[j],
+                       INVALID_ROUTE_2, code);
+            }
+
+            graph.insertRoute(IDs[i], IDs[j], bound * (1 + uniform()));
+        }
+
+        Snapshot snapshot(graph);
+        std::size_t srcID = IDs[std::rand() % IDs.size()],
+                    dstID = IDs[std::rand() % IDs.size()];
+
+        if (snapshot.find(srcID) >= snapshot.size() ||
+            snapshot.find(dstID) >= snapshot.size())
+            continue;
+
+        graph.initialize(srcID, dstID);
+        graph.findPath();
+        expect(near(dijkstra(snapshot, srcID, dstID), graph.getCosts(),
+                    1e-9 * graph.getCosts()),
+               "edit", srcID, dstID, dijkstra(snapshot, srcID, dstID),
+               graph.getCosts());
+    }
+}
+
+static void run(std::size_t size, std::size_t queries, std::size_t rounds)
+{
+    std::srand(seed);
+    Graph graph(seed % 4 ? 6371 : 0);
+    std::size_t next = 7 * size + 3;
+    std::vector<std::size_t> hot;
+
+    try
+    {
+        build(graph, size);
+
+        for (std::size_t i = 0; i < 4 && size; ++i)
+        {
+            hot.push_back(7 * (std::rand() % size) + 3);
+            graph.insertDestination(hot.back());
+        }
+
+        graph.updateBudget(seed % 3 ? (seed % 3) * 3 * size * sizeof(float)
+                                    : 1 << 26,
+                           seed % 3 == 1);
+
+        for (std::size_t r = 0; r < rounds; ++r)
+        {
+            compare(graph, queries, hot);
+            edit(graph, next, size / 10 + 1);
+        }
+    }
+    catch (int code)
+    {
+        expect(false, "exception", 0, 0, 0, code);
+    }
+}
+
+static void zero()
+{
+    Graph graph(0);
+    graph.insertPoint(1, 1.0, 0.1);
+    graph.insertPoint(2, 1.0, 0.1);
+    graph.insertPoint(3, 1.0, 0.1);
+    graph.insertRoute(3, 2, 0);
+    graph.insertRoute(2, 1, 0);
+    graph.insertRoute(1, 2, 0);
+
+    Snapshot snapshot(graph);
+    Stepping stepping(snapshot, 0, 2);
+    stepping.findCosts(3);
+    const std::vector<std::size_t> &prevs = stepping.getPrevs();
+    std::size_t curr = snapshot.find(1), hops = 0;
+
+    while (curr != (std::size_t)-1 && hops <= prevs.size())
+        curr = prevs[curr], ++hops;
+
+    expect(hops <= prevs.size(), "zero cycle", 3, 1, prevs.size(), hops);
+
+    if (hops <= prevs.size())
+        expect(stepping.getPath(1).size() == 3 &&
+                   stepping.getPath(1).front() == 3,
+               "zero path", 3, 1, 3, stepping.getPath(1).size());
+}
+
+static void sample(std::size_t, void *)
+{
+    for (std::size_t i = 1; i <= 1000; ++i)
+    {
+        Metrics::record(TIMER_WRITE, i * 1e-6);
+        Metrics::count(COUNTER_LOADED);
+    }
+}
+
+static void monitor()
+{
+    Metrics::reset();
+    Metrics::enable(true);
+    runThreads(4, sample, NULL);
+    double p50 = Metrics::getQuantile(TIMER_WRITE, 0.5),
+           p99 = Metrics::getQuantile(TIMER_WRITE, 0.99),
+           top = Metrics::getQuantile(TIMER_WRITE, 1);
+
+    expect(Metrics::countSamples(TIMER_WRITE) == 4000, "samples", 0, 0,
+           4000, Metrics::countSamples(TIMER_WRITE));
+    expect(Metrics::getCounter(COUNTER_LOADED) == 4000, "counter", 0, 0,
+           4000, Metrics::getCounter(COUNTER_LOADED));
+    expect(p50 >= 500e-6 && p50 <= 500e-6 * 33 / 32, "p50", 0, 0,
+           500e-6, p50);
+    expect(p99 >= 990e-6 && p99 <= 990e-6 * 33 / 32, "p99", 0, 0,
+           990e-6, p99);
+    expect(near(1000e-6, top, 1e-9), "max", 0, 0, 1000e-6, top);
+
+    Graph graph(6371);
+    build(graph, 20);
+    graph.insertDestination(3);
+
+    for (std::size_t q = 0; q < 3; ++q)
+    {
+        graph.initialize(10, 3);
+        graph.findPath();
+    }
+
+    expect(Metrics::countSamples(TIMER_FIND_PATH) == 3 &&
+               Metrics::getCounter(COUNTER_HITS) == 2 &&
+               Metrics::getCounter(COUNTER_MISSES) == 1 &&
+               Metrics::getCounter(COUNTER_VERSION) == graph.getVersion(),
+           "queries", 10, 3, 3, Metrics::countSamples(TIMER_FIND_PATH));
+
+    std::stringstream ss;
+    Metrics::dump(ss);
+    expect(ss.str().find("write_samples 4000\n") != std::string::npos &&
+               ss.str().find("cache_hit_rate ") != std::string::npos,
+           "dump", 0, 0, 0, ss.str().size());
+
+    Metrics::enable(false);
+    Metrics::reset();
+}
+
+static void full()
+{
+    std::vector<std::size_t> path(64, 3);
+
+    try
+    {
+        Writer writer("/dev/full", true, 64);
+
+        for (std::size_t i = 0; i < 16; ++i)
+            writer.writePath(path, i);
+
+        writer.close();
+        expect(false, "full", 0, 0, FILE_NOT_WRITTEN, 0);
+    }
+    catch (int code)
+    {
+        expect(code == FILE_NOT_WRITTEN || code == FILE_NOT_OPENED, "full",
+               0, 0, FILE_NOT_WRITTEN, code);
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    double seconds = argc > 1 ? std::atof(argv[1]) : 0,
+           start = now();
+    std::size_t first = argc > 2 ? std::atoi(argv[2]) : 1;
+    seed = first;
+    zero();
+    full();
+    monitor();
+
+    if (seconds <= 0)
+    {
+        static const std::size_t sizes[] = {1, 2, 40, 150, 400};
+
+        for (std::size_t i = 0; i < 5; ++i, ++seed)
+            run(sizes[i], 20, 3);
+    }
+    else
+        for (; now() - start < seconds; ++seed)
+            run(50 + std::rand() % 1500, 50, 5);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Checks: " << checks << ", Failures: " << failures
+              << ", Seeds: " << seed - first
+              << ", " << now() - start << "s" << std::endl;
+
+    return failures ? 1 : 0;
+}
\ No newline at end of file
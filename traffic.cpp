@@ -0,0 +1,402 @@
+#include "traffic.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+Turn::Turn(std::size_t prevID, std::size_t viaID, std::size_t nextID)
+{
+    this->prevID = prevID;
+    this->viaID = viaID;
+    this->nextID = nextID;
+}
+
+bool Turn::operator<(const Turn &other) const
+{
+    if (this->viaID != other.viaID)
+        return this->viaID < other.viaID;
+
+    if (this->prevID != other.prevID)
+        return this->prevID < other.prevID;
+
+    if (this->nextID != other.nextID)
+        return this->nextID < other.nextID;
+
+    return false;
+}
+
+
+Profiles::Profiles(double period, std::size_t slots)
+{
+    this->period = period;
+    this->slots = slots;
+    this->insert(std::vector<double>(slots, 1));
+}
+
+std::size_t Profiles::insert(const std::vector<double> &factors)
+{
+    if (factors.size() != this->slots)
+        throw INVALID_PROFILE;
+
+    std::vector<unsigned short> samples(this->slots);
+
+    for (std::size_t i = 0; i < this->slots; ++i)
+    {
+        if (!(factors[i] >= 1 && factors[i] < 17))
+            throw INVALID_PROFILE;
+
+        samples[i] = (unsigned short)std::floor(
+            (factors[i] - 1) * 4096 + 0.5);
+    }
+
+    std::map<std::vector<unsigned short>, std::size_t>::const_iterator
+        iter = this->lookup.find(samples);
+
+    if (iter != this->lookup.end())
+        return iter->second;
+
+    std::size_t profile = this->drops.size();
+    double drop = 0;
+
+    for (std::size_t i = 0; i < this->slots; ++i)
+        drop = std::max(drop,
+                        (samples[i] -
+                         (double)samples[(i + 1) % this->slots]) /
+                            4096);
+
+    this->samples.insert(this->samples.end(),
+                         samples.begin(), samples.end());
+    this->drops.push_back(drop);
+    this->lookup[samples] = profile;
+
+    return profile;
+}
+
+double Profiles::factor(std::size_t profile, double time) const
+{
+    double slot = (time / this->period -
+                   std::floor(time / this->period)) *
+                  this->slots;
+    std::size_t i = (std::size_t)slot % this->slots;
+    const unsigned short *samples = &this->samples[profile * this->slots];
+    double frac = slot - std::floor(slot);
+
+    return 1 + (samples[i] * (1 - frac) +
+                samples[(i + 1) % this->slots] * frac) /
+                   4096;
+}
+
+bool Profiles::check(std::size_t profile, double cost) const
+{
+    if (cost * this->drops[profile] > this->period / this->slots)
+        throw NON_FIFO_PROFILE;
+
+    return true;
+}
+
+double Profiles::getDrop(std::size_t profile) const
+{
+    return this->drops[profile];
+}
+
+double Profiles::getPeriod() const
+{
+    return this->period;
+}
+
+std::size_t Profiles::countSlots() const
+{
+    return this->slots;
+}
+
+std::size_t Profiles::size() const
+{
+    return this->drops.size();
+}
+
+
+Traffic::Traffic(double period, std::size_t slots)
+    : profiles(period, slots)
+{
+}
+
+std::size_t Traffic::insertProfile(const std::vector<double> &factors)
+{
+    return this->profiles.insert(factors);
+}
+
+void Traffic::assignProfile(const Graph &graph,
+                            std::size_t srcID, std::size_t dstID,
+                            std::size_t profile)
+{
+    double cost = graph.getCost(srcID, dstID);
+
+    if (cost == std::numeric_limits<double>::infinity())
+        throw MISSING_ROUTE;
+
+    if (profile >= this->profiles.size())
+        throw INVALID_PROFILE;
+
+    if (profile && this->profiles.check(profile, cost))
+        this->assigned[Route(srcID, dstID)] = profile;
+    else
+        this->assigned.erase(Route(srcID, dstID));
+}
+
+void Traffic::insertTurn(std::size_t prevID, std::size_t viaID,
+                         std::size_t nextID, double cost)
+{
+    if (cost < 0)
+        throw NEGATIVE_TURN;
+
+    this->turns[Turn(prevID, viaID, nextID)] = cost;
+}
+
+void Traffic::eraseTurn(std::size_t prevID, std::size_t viaID,
+                        std::size_t nextID)
+{
+    this->turns.erase(Turn(prevID, viaID, nextID));
+}
+
+void Traffic::clear()
+{
+    this->assigned.clear();
+    this->turns.clear();
+}
+
+bool Traffic::empty() const
+{
+    return this->assigned.empty() && this->turns.empty();
+}
+
+const Profiles &Traffic::getProfiles() const
+{
+    return this->profiles;
+}
+
+std::size_t Traffic::getProfile(std::size_t srcID,
+                                std::size_t dstID) const
+{
+    std::map<Route, std::size_t>::const_iterator iter =
+        this->assigned.find(Route(srcID, dstID));
+
+    return iter == this->assigned.end() ? 0 : iter->second;
+}
+
+void Traffic::copy(std::vector<Turn> &turns,
+                   std::vector<double> &costs) const
+{
+    std::map<Turn, double>::const_iterator
+        const_lower = this->turns.begin(),
+        const_upper = this->turns.end(),
+        const_iter;
+
+    for (const_iter = const_lower;
+         const_iter != const_upper; ++const_iter)
+    {
+        turns.push_back(const_iter->first);
+        costs.push_back(const_iter->second);
+    }
+}
+
+
+static std::size_t findArc(const Snapshot &snapshot,
+                           std::size_t src, std::size_t dst)
+{
+    if (src >= snapshot.size())
+        return -1;
+
+    for (std::size_t e = snapshot.begin(src); e < snapshot.end(src); ++e)
+        if (snapshot.target(e) == dst)
+            return e;
+
+    return -1;
+}
+
+double Journey::getTurn(std::size_t in, std::size_t out) const
+{
+    std::pair<std::pair<std::size_t, std::size_t>, double> key(
+        std::make_pair(in, out), -std::numeric_limits<double>::infinity());
+    std::vector<std::pair<std::pair<std::size_t, std::size_t>,
+                          double> >::const_iterator iter =
+        std::lower_bound(this->turns.begin(), this->turns.end(), key);
+
+    if (iter == this->turns.end() || iter->first != key.first)
+        return 0;
+
+    return iter->second;
+}
+
+Journey::Journey(const Snapshot &snapshot, const Traffic &traffic)
+    : snapshot(snapshot), traffic(traffic), search(snapshot)
+{
+    this->dynamic = !traffic.empty();
+    this->last = -1;
+    this->departure = 0;
+    this->expanded = 0;
+
+    if (!this->dynamic)
+        return;
+
+    std::size_t arcs = snapshot.countArcs();
+    this->profiles.assign(arcs, 0);
+    this->heads.resize(arcs + 1);
+    this->turny.assign(snapshot.size(), 0);
+
+    for (std::size_t v = 0; v < snapshot.size(); ++v)
+        for (std::size_t e = snapshot.begin(v); e < snapshot.end(v); ++e)
+        {
+            this->heads[e] = snapshot.target(e);
+            this->profiles[e] = traffic.getProfile(
+                snapshot.getID(v), snapshot.getID(snapshot.target(e)));
+
+            if (this->profiles[e])
+                traffic.getProfiles().check(this->profiles[e],
+                                            snapshot.cost(e));
+        }
+
+    std::vector<Turn> turns;
+    std::vector<double> costs;
+    traffic.copy(turns, costs);
+
+    for (std::size_t i = 0; i < turns.size(); ++i)
+    {
+        std::size_t prev = snapshot.find(turns[i].prevID),
+                    via = snapshot.find(turns[i].viaID),
+                    next = snapshot.find(turns[i].nextID),
+                    in = findArc(snapshot, prev, via),
+                    out = findArc(snapshot, via, next);
+
+        if (in == (std::size_t)-1 || out == (std::size_t)-1)
+            continue;
+
+        this->turns.push_back(std::make_pair(std::make_pair(in, out),
+                                             costs[i]));
+        this->turny[via] = 1;
+    }
+
+    std::sort(this->turns.begin(), this->turns.end());
+}
+
+void Journey::findPath(std::size_t srcID, std::size_t dstID,
+                       double departure)
+{
+    this->departure = departure;
+    this->last = -1;
+    this->expanded = 0;
+
+    if (!this->dynamic)
+    {
+        this->search.findPath(srcID, dstID);
+        this->expanded = this->search.countExpanded();
+        return;
+    }
+
+    std::size_t src = this->snapshot.find(srcID),
+                dst = this->snapshot.find(dstID),
+                start = this->snapshot.countArcs();
+
+    if (src >= this->snapshot.size() || dst >= this->snapshot.size())
+        return;
+
+    const Profiles &profiles = this->traffic.getProfiles();
+    Spherical<Snapshot> heuristic;
+    heuristic.reset(this->snapshot, dst);
+    this->space.reset(start + 1);
+    this->queue.clear();
+    this->heads[start] = src;
+    this->space.stamps[start] = this->space.stamp;
+    this->space.costs[start] = departure;
+    this->space.prevs[start] = -1;
+    this->space.bounds[start] = heuristic(this->snapshot, src);
+    this->queue.push(departure + this->space.bounds[start], start);
+
+    while (!this->queue.empty())
+    {
+        double key = this->queue.top().first;
+        std::size_t e = this->queue.top().second,
+                    v = this->heads[e];
+        this->queue.pop();
+        double time = this->space.costs[e];
+
+        if (key > time + this->space.bounds[e])
+            continue;
+
+        if (v == dst)
+        {
+            this->last = e;
+            break;
+        }
+
+        ++this->expanded;
+
+        for (std::size_t f = this->snapshot.begin(v);
+             f < this->snapshot.end(v); ++f)
+        {
+            double turn = e == start || !this->turny[v]
+                              ? 0
+                              : this->getTurn(e, f);
+
+            if (turn == std::numeric_limits<double>::infinity())
+                continue;
+
+            double leave = time + turn,
+                   cost = this->snapshot.cost(f);
+
+            if (this->profiles[f])
+                cost *= profiles.factor(this->profiles[f], leave);
+
+            if (!this->space.seen(f))
+            {
+                this->space.stamps[f] = this->space.stamp;
+                this->space.costs[f] = std::numeric_limits<double>::infinity();
+                this->space.bounds[f] = heuristic(this->snapshot,
+                                                  this->heads[f]);
+            }
+
+            if (leave + cost < this->space.costs[f])
+            {
+                this->space.costs[f] = leave + cost;
+                this->space.prevs[f] = e;
+                this->queue.push(leave + cost + this->space.bounds[f], f);
+            }
+        }
+    }
+}
+
+std::size_t Journey::countExpanded() const
+{
+    return this->expanded;
+}
+
+std::vector<std::size_t> Journey::getPath() const
+{
+    if (!this->dynamic)
+        return this->search.getPath();
+
+    std::vector<std::size_t> path;
+
+    for (std::size_t e = this->last; e != (std::size_t)-1;
+         e = this->space.prevs[e])
+        path.push_back(this->snapshot.getID(this->heads[e]));
+
+    std::reverse(path.begin(), path.end());
+
+    return path;
+}
+
+double Journey::getCosts() const
+{
+    return this->getArrival() - this->departure;
+}
+
+double Journey::getArrival() const
+{
+    if (!this->dynamic)
+        return this->departure + this->search.getCosts();
+
+    if (this->last == (std::size_t)-1)
+        return std::numeric_limits<double>::infinity();
+
+    return this->space.costs[this->last];
+}
\ No newline at end of file
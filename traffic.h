@@ -0,0 +1,112 @@
+#ifndef TRAFFIC_H
+#define TRAFFIC_H
+
+#include "search.h"
+
+
+#ifndef INVALID_PROFILE
+#define INVALID_PROFILE 51
+#endif
+
+#ifndef NON_FIFO_PROFILE
+#define NON_FIFO_PROFILE 52
+#endif
+
+#ifndef NEGATIVE_TURN
+#define NEGATIVE_TURN 53
+#endif
+
+#ifndef MISSING_ROUTE
+#define MISSING_ROUTE 54
+#endif
+
+
+struct Turn
+{
+    std::size_t prevID;
+    std::size_t viaID;
+    std::size_t nextID;
+
+    Turn(std::size_t, std::size_t, std::size_t);
+
+    bool operator<(const Turn &) const;
+};
+
+
+class Profiles
+{
+    double period;
+    std::size_t slots;
+    std::vector<unsigned short> samples;
+    std::vector<double> drops;
+    std::map<std::vector<unsigned short>, std::size_t> lookup;
+
+public:
+    Profiles(double, std::size_t);
+
+    std::size_t insert(const std::vector<double> &);
+    double factor(std::size_t, double) const;
+    bool check(std::size_t, double) const;
+    double getDrop(std::size_t) const;
+    double getPeriod() const;
+    std::size_t countSlots() const;
+    std::size_t size() const;
+};
+
+
+class Traffic
+{
+    Profiles profiles;
+    std::map<Route, std::size_t> assigned;
+    std::map<Turn, double> turns;
+
+public:
+    Traffic(double = 86400, std::size_t = 96);
+
+    std::size_t insertProfile(const std::vector<double> &);
+    void assignProfile(const Graph &, std::size_t, std::size_t,
+                       std::size_t);
+    void insertTurn(std::size_t, std::size_t, std::size_t,
+                    double);
+    void eraseTurn(std::size_t, std::size_t, std::size_t);
+    void clear();
+    bool empty() const;
+    const Profiles &getProfiles() const;
+    std::size_t getProfile(std::size_t, std::size_t) const;
+    void copy(std::vector<Turn> &,
+              std::vector<double> &) const;
+};
+
+
+class Journey
+{
+    const Snapshot &snapshot;
+    const Traffic &traffic;
+    bool dynamic;
+    Search search;
+    std::vector<std::size_t> profiles;
+    std::vector<char> turny;
+    std::vector<std::pair<std::pair<std::size_t, std::size_t>,
+                          double> >
+        turns;
+    std::vector<std::size_t> heads;
+    Workspace<double> space;
+    BinaryHeap<double> queue;
+    std::size_t last;
+    double departure;
+    std::size_t expanded;
+
+    double getTurn(std::size_t, std::size_t) const;
+
+public:
+    Journey(const Snapshot &, const Traffic &);
+
+    void findPath(std::size_t, std::size_t, double = 0);
+    std::size_t countExpanded() const;
+    std::vector<std::size_t> getPath() const;
+    double getCosts() const;
+    double getArrival() const;
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,289 @@
+#include "writer.h"
+#include "metrics.h"
+#include <cstring>
+#if __cplusplus >= 201103L
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+
+struct Worker
+{
+#if __cplusplus >= 201103L
+    std::FILE *file;
+    bool closing;
+    bool failed;
+    std::vector<char> pending;
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::thread thread;
+
+    Worker(std::FILE *);
+
+    void run();
+    bool submit(std::vector<char> &);
+    void stop();
+#endif
+};
+
+
+#if __cplusplus >= 201103L
+Worker::Worker(std::FILE *file)
+{
+    this->file = file;
+    this->closing = false;
+    this->failed = false;
+    this->thread = std::thread(&Worker::run, this);
+}
+
+void Worker::run()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    while (true)
+    {
+        this->cond.wait(lock, [this]
+                        { return this->closing ||
+                                 !this->pending.empty(); });
+
+        if (this->pending.empty())
+            return;
+
+        lock.unlock();
+        bool written = std::fwrite(&this->pending[0], 1,
+                                   this->pending.size(),
+                                   this->file) == this->pending.size();
+        lock.lock();
+        this->failed = this->failed || !written;
+        this->pending.clear();
+        this->cond.notify_all();
+    }
+}
+
+bool Worker::submit(std::vector<char> &buffer)
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->cond.wait(lock, [this]
+                    { return this->pending.empty(); });
+    this->pending.swap(buffer);
+    this->cond.notify_all();
+
+    return !this->failed;
+}
+
+void Worker::stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->closing = true;
+        this->cond.notify_all();
+    }
+
+    this->thread.join();
+}
+#endif
+
+
+void Writer::reserve(std::size_t size)
+{
+    if (this->failed)
+        throw FILE_NOT_WRITTEN;
+
+    if (this->buffer.size() + size > this->capacity)
+        this->flush();
+}
+
+void Writer::flush()
+{
+    if (this->buffer.empty())
+        return;
+
+#if __cplusplus >= 201103L
+    if (!this->worker->submit(this->buffer))
+        this->failed = true;
+#else
+    if (std::fwrite(&this->buffer[0], 1, this->buffer.size(),
+                    this->file) != this->buffer.size())
+        this->failed = true;
+#endif
+
+    this->buffer.clear();
+    this->buffer.reserve(this->capacity);
+}
+
+void Writer::writeVarint(std::size_t value)
+{
+    this->reserve(10);
+
+    while (value >= 0x80)
+    {
+        this->buffer.push_back((char)((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+
+    this->buffer.push_back((char)value);
+}
+
+Writer::Writer(const std::string &fileName, bool binary,
+               std::size_t capacity)
+{
+    this->file = std::fopen(fileName.c_str(), binary ? "wb" : "w");
+
+    if (!this->file)
+        throw FILE_NOT_OPENED;
+
+    std::setvbuf(this->file, NULL, _IONBF, 0);
+    this->binary = binary;
+    this->failed = false;
+    this->capacity = capacity;
+    this->buffer.reserve(capacity);
+
+#if __cplusplus >= 201103L
+    this->worker = new Worker(this->file);
+#else
+    this->worker = NULL;
+#endif
+}
+
+Writer::~Writer()
+{
+    try
+    {
+        this->close();
+    }
+    catch (int)
+    {
+    }
+}
+
+void Writer::write(char value)
+{
+    this->reserve(1);
+    this->buffer.push_back(value);
+}
+
+void Writer::write(std::size_t value)
+{
+    char digits[24];
+    std::size_t size = 0;
+
+    do
+    {
+        digits[size++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+
+    this->reserve(size);
+
+    while (size)
+        this->buffer.push_back(digits[--size]);
+}
+
+void Writer::write(double value, int precision)
+{
+    char text[32];
+    int size = std::sprintf(text, "%.*g", precision, value);
+    this->reserve(size);
+    this->buffer.insert(this->buffer.end(), text, text + size);
+}
+
+void Writer::writePath(const std::vector<std::size_t> &path,
+                       double costs)
+{
+    Timer timer(TIMER_WRITE);
+
+    if (!this->binary)
+    {
+        for (std::size_t i = 0; i < path.size(); ++i)
+            this->write(path[i]), this->write('\n');
+
+        this->write(costs, 15), this->write('\n');
+        return;
+    }
+
+    this->writeVarint(path.size());
+    std::size_t prevID = 0;
+
+    for (std::size_t i = 0; i < path.size(); ++i)
+    {
+        std::size_t delta = path[i] - prevID,
+                    sign = delta >> (sizeof(std::size_t) * 8 - 1);
+        this->writeVarint((delta << 1) ^ ((std::size_t)0 - sign));
+        prevID = path[i];
+    }
+
+    char bytes[sizeof(double)];
+    std::memcpy(bytes, &costs, sizeof(double));
+    this->reserve(sizeof(double));
+    this->buffer.insert(this->buffer.end(),
+                        bytes, bytes + sizeof(double));
+}
+
+void Writer::close()
+{
+    if (!this->file)
+        return;
+
+    this->flush();
+
+#if __cplusplus >= 201103L
+    this->worker->stop();
+    this->failed = this->failed || this->worker->failed;
+    delete this->worker;
+    this->worker = NULL;
+#endif
+
+    if (std::fclose(this->file))
+        this->failed = true;
+
+    this->file = NULL;
+
+    if (this->failed)
+        throw FILE_NOT_WRITTEN;
+}
+
+
+static std::size_t readVarint(const std::vector<unsigned char> &bytes,
+                              std::size_t &pos)
+{
+    std::size_t value = 0;
+
+    for (unsigned shift = 0;; shift += 7)
+    {
+        if (pos >= bytes.size() || shift >= sizeof(std::size_t) * 8)
+            throw INVALID_PATH;
+
+        unsigned char byte = bytes[pos++];
+        value |= (std::size_t)(byte & 0x7F) << shift;
+
+        if (!(byte & 0x80))
+            return value;
+    }
+}
+
+std::vector<std::size_t> readPath(const std::vector<unsigned char> &bytes,
+                                  std::size_t &pos, double &costs)
+{
+    std::size_t size = readVarint(bytes, pos), prevID = 0;
+
+    if (size > bytes.size() - pos)
+        throw INVALID_PATH;
+
+    std::vector<std::size_t> path(size);
+
+    for (std::size_t i = 0; i < path.size(); ++i)
+    {
+        std::size_t delta = readVarint(bytes, pos);
+        prevID += (delta >> 1) ^ ((std::size_t)0 - (delta & 1));
+        path[i] = prevID;
+    }
+
+    if (sizeof(double) > bytes.size() - pos)
+        throw INVALID_PATH;
+
+    std::memcpy(&costs, &bytes[pos], sizeof(double));
+    pos += sizeof(double);
+
+    return path;
+}
\ No newline at end of file
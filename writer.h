@@ -0,0 +1,58 @@
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+#ifndef FILE_NOT_OPENED
+#define FILE_NOT_OPENED 2
+#endif
+
+#ifndef INVALID_PATH
+#define INVALID_PATH 62
+#endif
+
+#ifndef FILE_NOT_WRITTEN
+#define FILE_NOT_WRITTEN 63
+#endif
+
+
+struct Worker;
+
+
+class Writer
+{
+    std::FILE *file;
+    bool binary;
+    bool failed;
+    std::size_t capacity;
+    std::vector<char> buffer;
+    Worker *worker;
+
+    Writer(const Writer &);
+    Writer &operator=(const Writer &);
+
+    void reserve(std::size_t);
+    void flush();
+    void writeVarint(std::size_t);
+
+public:
+    Writer(const std::string &, bool = false,
+           std::size_t = 1 << 20);
+    ~Writer();
+
+    void write(char);
+    void write(std::size_t);
+    void write(double, int);
+    void writePath(const std::vector<std::size_t> &, double);
+    void close();
+};
+
+
+std::vector<std::size_t> readPath(const std::vector<unsigned char> &,
+                                  std::size_t &, double &);
+
+
+#endif
\ No newline at end of file